@@ -816,6 +816,17 @@
  */
 #if DISABLED(CLASSIC_JERK)
   #define JUNCTION_DEVIATION_MM 0.013 // (mm) Distance from real junction edge
+
+  /**
+   * Fit a circle to the last moves. When they follow it closely (a curve cut
+   * into short lines) the junctions run at the centripetal speed limit of
+   * that circle, using the axis accelerations across the curve (M201).
+   * Other junctions are also kept under the speed of their own circle.
+   */
+  //#define JUNCTION_CURVATURE
+  #if ENABLED(JUNCTION_CURVATURE)
+    #define JUNCTION_CURVE_DEVIATION 0.05 // (mm) Largest gap between the moves and the circle of a curve
+  #endif
 #endif
 
 /**
@@ -1276,6 +1287,52 @@
       #define BILINEAR_SUBDIVISIONS 3
     #endif
 
+    //
+    // Interpolate the mesh with bicubic (Catmull-Rom) patches made from the
+    // probed points as they are needed. The surface is smoother than bilinear,
+    // so fewer probe points may do. Cartesian machines need SEGMENT_LEVELED_MOVES
+    // or LEVELING_STREAM to follow the surface between grid lines.
+    //
+    //#define ABL_BICUBIC
+    #if ENABLED(ABL_BICUBIC)
+      #define ABL_BICUBIC_CACHE 4     // Number of grid cells with their patch kept in RAM
+    #endif
+
+    //
+    // Leave Cartesian moves unsplit and follow the mesh between their ends
+    // with a stream of Z steps from the Stepper ISR. The planner gets fewer,
+    // longer blocks. Requires SEGMENT_LEVELED_MOVES to be disabled.
+    //
+    //#define LEVELING_STREAM
+    #if ENABLED(LEVELING_STREAM)
+      #define LEVELING_STREAM_RATE 1000 // (Hz) Mesh lookups per second, each followed by up to one Z step
+    #endif
+
+    //
+    // Probe a coarse grid first, then probe the points in between only where
+    // a plane fitted to the surrounding points doesn't match within the given
+    // threshold. Skipped points are interpolated, so flat beds need far fewer
+    // probes. Override the threshold with 'G29 K', or probe every point with 'G29 K0'.
+    //
+    //#define ABL_ADAPTIVE_PROBING
+    #if ENABLED(ABL_ADAPTIVE_PROBING)
+      #define ABL_ADAPTIVE_STRIDE      2  // Spacing of the coarse grid, in grid points. A power of 2.
+      #define ABL_ADAPTIVE_THRESHOLD 0.03 // (mm) Largest plane-fit residual left unrefined
+    #endif
+
+    //
+    // With 'G29 U' probe only the grid points around the print area, keeping
+    // the rest of the stored mesh. The area is given by 'L R F B' or read from
+    // the header of the SD file being printed (";MINX:" ";MINY:" ";MAXX:" ";MAXY:"
+    // as written by Cura). With no stored mesh the print area is probed as a new grid,
+    // and a stored grid that doesn't cover the print area is probed again over both.
+    //
+    //#define G29_PRINT_AREA
+    #if ENABLED(G29_PRINT_AREA)
+      #define PRINT_AREA_MARGIN        10 // (mm) Added on each side of the print area
+      #define PRINT_AREA_HEADER_BYTES 2048 // Bytes at the start of an SD file searched for the print area
+    #endif
+
   #endif
 
 #elif ENABLED(AUTO_BED_LEVELING_UBL)
@@ -835,6 +835,82 @@
  */
 //#define ADAPTIVE_STEP_SMOOTHING
 
+/**
+ * S-Curve Lookup Table (32-bit only)
+ *
+ * Evaluate the S_CURVE_ACCELERATION speed curve in the Stepper ISR from a
+ * 257-point table of the normalized Bézier curve, with linear interpolation,
+ * instead of the 5th order polynomial and its 64-bit multiplies. The speed
+ * stays within 8 steps/s of the polynomial.
+ * Check with buildroot/share/scripts/createBezierLookupTable.py --check
+ */
+//#define S_CURVE_LOOKUP_TABLE
+
+/**
+ * S-Curve Junctions (32-bit only)
+ *
+ * With S_CURVE_ACCELERATION every block ramps from and to zero acceleration,
+ * so a run of short blocks that accelerate (or brake) together is one long
+ * chain of jerk pulses. This option carries the acceleration through each
+ * such junction (at the lower of the two block accelerations) by bending
+ * the Bézier ramps on both sides. Ramp lengths and times are unchanged and
+ * the peak acceleration is never above that of the plain S-curve.
+ * Blocks run from a STEP_SCHEDULE pulse train keep the plain ramps.
+ */
+//#define S_CURVE_JUNCTIONS
+
+/**
+ * Precomputed Step Schedule (32-bit only)
+ *
+ * The main loop compiles the next few planned blocks into tables of
+ * constant-interval segments, so the Stepper ISR only pops the next interval
+ * instead of evaluating the trapezoid (or S-Curve) for every step. This frees
+ * ISR time for higher step rates with less multi-stepping.
+ *
+ * Within a segment the step interval may deviate by up to 1/TOLERANCE from
+ * the exact profile. A block needing more than STEP_SCHEDULE_SEGMENTS, or one
+ * reached by the ISR before it was compiled, runs the usual way.
+ * RAM use is about (LOOKAHEAD + 1, rounded up to a power of 2) * SEGMENTS * 8 bytes.
+ */
+//#define STEP_SCHEDULE
+#if ENABLED(STEP_SCHEDULE)
+  #define STEP_SCHEDULE_SEGMENTS   96 // Maximum segments per block
+  #define STEP_SCHEDULE_TOLERANCE  32 // Interval tolerance within a segment (1/N)
+  #define STEP_SCHEDULE_LOOKAHEAD   3 // Blocks to compile ahead of the Stepper ISR
+#endif
+
+/**
+ * Input Shaping
+ *
+ * Cancel the ringing of the X and Y axes to print faster without ghosting.
+ * The Stepper ISR outputs each X / Y step as 2 or 3 weighted impulses, the
+ * later ones delayed so that the ringing they excite cancels out:
+ *
+ *   SHAPER_ZV  : 2 impulses over 1/2 period. Shortest delay, least tolerant to frequency error.
+ *   SHAPER_ZVD : 3 impulses over 1 period. Most tolerant, most smoothing.
+ *   SHAPER_MZV : 3 impulses over 3/4 period. In between.
+ *
+ * To find the frequency print a test part at constant speed and measure the
+ * spacing of the ghosts after a corner: frequency (Hz) = speed / spacing.
+ * A frequency of 0 turns shaping off for that axis.
+ *
+ * Use M593 to change the settings at runtime, M500 to save them.
+ *
+ * The step times buffer must cover the longest delay (up to 1/frequency) at
+ * the highest step rate of the axis. Steps that don't fit are output unshaped.
+ * RAM use is 8 * SHAPING_BUFFER_SIZE bytes.
+ */
+//#define INPUT_SHAPING
+#if ENABLED(INPUT_SHAPING)
+  #define SHAPING_FREQ_X      40          // (Hz) Ringing frequency of the X axis
+  #define SHAPING_FREQ_Y      40          // (Hz) Ringing frequency of the Y axis
+  #define SHAPING_ZETA_X      0.1         // Damping ratio of the X axis (0 to 0.99)
+  #define SHAPING_ZETA_Y      0.1         // Damping ratio of the Y axis (0 to 0.99)
+  #define SHAPING_TYPE_X      SHAPER_MZV
+  #define SHAPING_TYPE_Y      SHAPER_MZV
+  #define SHAPING_BUFFER_SIZE 512         // Step times buffered per axis
+#endif
+
 /**
  * Custom Microstepping
  * Override as-needed for your setup. Up to 3 MS pins are supported.
@@ -1101,6 +1177,37 @@
    */
   //#define AUTO_REPORT_SD_STATUS
 
+  /**
+   * Read the file being printed a whole 512-byte block at a time into a
+   * buffer of its own, instead of one byte per call through the file system.
+   * Comments are skipped in bulk. Uses 512 bytes of RAM.
+   */
+  //#define SD_BLOCK_READER
+  #if ENABLED(SD_BLOCK_READER)
+    /**
+     * Read ahead (LPC176x only)
+     *
+     * Keep the next few blocks of the file coming in with a multiple block
+     * read (CMD18) while the queue works on the current one. The SPI takes
+     * each block in by DMA, so the main loop doesn't wait on the card.
+     * The SD card must not share its SPI bus with other devices.
+     * Uses SD_READ_AHEAD_BLOCKS * 512 bytes of RAM from the heap.
+     */
+    //#define SD_READ_AHEAD
+    #if ENABLED(SD_READ_AHEAD)
+      #define SD_READ_AHEAD_BLOCKS 4
+    #endif
+  #endif
+
+  /**
+   * Print pre-tokenized G-code files, as written by
+   * buildroot/share/scripts/gcode2bin.py. Each command is stored as its
+   * letter, number, and parameter values in binary, so the commands go to
+   * the queue without any text parsing. Plain G-code files still work.
+   * Requires FASTER_GCODE_PARSER.
+   */
+  //#define BINARY_GCODE
+
   /**
    * Support for USB thumb drives using an Arduino USB Host Shield or
    * equivalent MAX3421E breakout board. The USB thumb drive will appear
@@ -1474,6 +1581,16 @@
   //#define EXTRA_LIN_ADVANCE_K // Enable for second linear advance constants
   #define LIN_ADVANCE_K 0.22    // Unit: mm compression per 1mm/s extruder speed
   //#define LA_DEBUG            // If enabled, this will generate debug information output over USB.
+
+  /**
+   * Step the advance with the other axes instead of in bursts from its own ISR.
+   * The advance follows K times the actual extruder speed, so it also suits
+   * S_CURVE_ACCELERATION. It's smoothed over a short time to soften speed jumps.
+   */
+  //#define LA_PRESSURE_SMOOTHING
+  #if ENABLED(LA_PRESSURE_SMOOTHING)
+    #define LA_SMOOTH_TIME 0.01 // (s) Time constant of the advance smoothing
+  #endif
 #endif
 
 // @section leveling
@@ -1589,6 +1706,10 @@
   //#define ARC_SEGMENTS_PER_R    1 // Max segment length, MM_PER = Min
   #define MIN_ARC_SEGMENTS       24 // Minimum number of segments in a complete circle
   //#define ARC_SEGMENTS_PER_SEC 50 // Use feedrate to choose segment length (with MM_PER_ARC_SEGMENT as the minimum)
+  //#define ARC_CHORD_TOLERANCE 0.005 // (mm) Use the radius to choose segment length for this max deviation from the arc,
+                                      // with MM_PER_ARC_SEGMENT and ARC_SEGMENTS_PER_SEC (if set) as the minimum
+  //#define ARC_JUNCTION_SPEED      // Run the junctions within an arc at the centripetal speed limit of the arc radius
+                                    // instead of the Junction Deviation estimate. Requires Junction Deviation.
   #define N_ARC_CORRECTION       25 // Number of interpolated segments between corrections
   //#define ARC_P_CIRCLES           // Enable the 'P' parameter to specify complete circles
   //#define CNC_WORKSPACE_PLANES    // Allow G2/G3 to operate in XY, ZX, or YZ planes
@@ -1613,6 +1734,31 @@
 // Moves (or segments) with fewer steps than this will be joined with the next move
 #define MIN_STEPS_PER_SEGMENT 6
 
+/**
+ * Segment Coalescing
+ *
+ * Merge runs of short, nearly collinear moves into a single planner block.
+ * Curves sliced from STL meshes arrive as dozens of tiny G1 moves that are
+ * straight to within a few microns. Merging them saves planner work and
+ * leaves the look-ahead buffer covering more of the path.
+ *
+ * Moves are merged while they keep the same feedrate, tool and E/mm ratio,
+ * and no dropped point lies farther than SEGMENT_COALESCE_TOLERANCE from the
+ * merged line. A merged block ends on the exact step target of its last move,
+ * so the steppers arrive at the same positions as without merging.
+ *
+ * A move is only held back while the planner has enough blocks queued to
+ * keep the steppers busy. Not for kinematic machines.
+ */
+//#define SEGMENT_COALESCING
+#if ENABLED(SEGMENT_COALESCING)
+  #define SEGMENT_COALESCE_TOLERANCE  0.005 // (mm) Chord tolerance of the merged line
+  #define SEGMENT_COALESCE_E_RATIO    0.02  // Allowed relative change of the E/mm ratio
+  #define SEGMENT_COALESCE_MAX_LENGTH 1.0   // (mm) Only merge moves shorter than this
+  #define SEGMENT_COALESCE_MAX_MOVES  16    // Most moves merged into one block
+  #define SEGMENT_COALESCE_MIN_QUEUED 4     // Blocks that must be queued to hold a move back
+#endif
+
 /**
  * Minimum delay before and after setting the stepper DIR (in ns)
  *     0 : No delay (Expect at least 10µS since one Stepper ISR must transpire)
@@ -1669,11 +1815,8 @@
 
 // The number of linear motions that can be in the plan at any give time.
 // THE BLOCK_BUFFER_SIZE NEEDS TO BE A POWER OF 2 (e.g. 8, 16, 32) because shifts and ors are used to do the ring-buffering.
-#if ENABLED(SDSUPPORT)
-  #define BLOCK_BUFFER_SIZE 16 // SD,LCD,Buttons take more memory, block buffer needs to be smaller
-#else
-  #define BLOCK_BUFFER_SIZE 16 // maximize block buffer
-#endif
+// 32-bit boards have the RAM for up to 128. A deeper plan means fewer forced slow-downs on dense curves.
+#define BLOCK_BUFFER_SIZE 64
 
 // @section serial
 
@@ -1681,6 +1824,21 @@
 #define MAX_CMD_SIZE 128
 #define BUFSIZE 8
 
+/**
+ * Compact command queue
+ *
+ * Pack the queued commands back to back in COMMAND_QUEUE_BYTES of RAM
+ * instead of giving each one MAX_CMD_SIZE bytes. G, M, and T commands are
+ * tokenized as they're queued (as with BINARY_GCODE), so a short move takes
+ * far less room and isn't parsed again when it runs. BUFSIZE only limits
+ * the number of queued commands (up to 255), so raise it to let the host
+ * stream more short moves ahead. Requires FASTER_GCODE_PARSER.
+ */
+//#define COMPACT_COMMAND_QUEUE
+#if ENABLED(COMPACT_COMMAND_QUEUE)
+  #define COMMAND_QUEUE_BYTES 1024
+#endif
+
 // Transmission to Host Buffer Size
 // To save 386 bytes of PROGMEM (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
 // To buffer a simple "ok" you need 4 bytes.
@@ -1730,6 +1888,17 @@
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 //#define ADVANCED_OK
 
+// Estimate the time until the planner runs dry and count the underruns,
+// where it ran dry during a print, with the longest and total stall.
+// Report with M576. Set an auto-report interval with M576 S<seconds>.
+// With less than BUFFER_LOW_TIME of moves planned, moves from the host get
+// their "ok" as soon as they're queued, and commands already read (from SD
+// or the host) are run back-to-back ahead of the idle tasks.
+//#define BUFFER_MONITORING
+#if ENABLED(BUFFER_MONITORING)
+  #define BUFFER_LOW_TIME 100 // (ms)
+#endif
+
 // Printrun may have trouble receiving long strings all at once.
 // This option inserts short delays between lines of serial output.
 #define SERIAL_OVERRUN_PROTECTION
@@ -2769,6 +2938,12 @@
  */
 #define FASTER_GCODE_PARSER
 
+/**
+ * Read G-code numbers with a small decimal parser instead of strtof.
+ * The values are the same, for much less work on each X, Y, E, and F.
+ */
+//#define FAST_FLOAT_PARSER
+
 /**
  * CNC G-code options
  * Support CNC-style G-code dialects used by laser cutters, drawing machine cams, etc.
@@ -3096,3 +3271,20 @@
 
 // Enable Marlin dev mode which adds some special commands
 //#define MARLIN_DEV_MODE
+
+//
+// Count the blocks visited by the planner look-ahead passes.
+// Used by the Linux simulator planner benchmark (--planner-bench).
+//
+//#define PLANNER_STATS
+
+//
+// Profile the Stepper ISR with the CPU cycle counter (LPC176x DWT, Linux host clock).
+// Keeps min/avg/max cycles and a histogram for each phase of the ISR, and counts
+// the extra passes taken to catch up when the ISR falls behind.
+// Report with M215. Set an auto-report interval with M215 S<seconds>.
+//
+//#define STEPPER_ISR_PROFILE
+#if ENABLED(STEPPER_ISR_PROFILE)
+  #define STEPPER_ISR_PROFILE_BINS 8  // Histogram bins: <1µs, <2µs, <4µs ... the last takes the rest
+#endif
@@ -80,6 +80,15 @@ extern HalSerial usb_serial;
 
 inline void HAL_init() {}
 
+// Cycle counter, read from the host clock so fast-forward time is left alone
+#define HAS_CYCLE_COUNTER 1
+inline void HAL_cycle_counter_init() {}
+inline uint32_t HAL_cycle_count() { return Clock::hostCycles(); }
+
+// Feeds input and advances time in fast-forward mode
+#define HAL_IDLETASK 1
+void HAL_idletask();
+
 // Utility functions
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-function"
@@ -29,4 +29,38 @@ std::chrono::nanoseconds Clock::startup = std::chrono::high_resolution_clock::no
 uint32_t Clock::frequency = F_CPU;
 double Clock::time_multiplier = 1.0;
 
+bool Clock::virtual_time = false;
+bool Clock::dispatching = false;
+uint64_t Clock::virtual_nanos = 0;
+uint64_t Clock::event_sequence = 0;
+std::priority_queue<Clock::Event, std::vector<Clock::Event>, std::greater<Clock::Event>> Clock::events;
+
+void Clock::schedule(uint64_t deadline, event_fn* fn, void* context, uint32_t tag) {
+  // Sequence number keeps events with equal deadlines in FIFO order
+  Clock::events.push({ deadline, Clock::event_sequence++, fn, context, tag });
+}
+
+void Clock::dispatch(uint64_t until) {
+  // Events run one at a time, like ISRs of equal priority
+  Clock::dispatching = true;
+  while (!Clock::events.empty() && Clock::events.top().deadline <= until) {
+    const Event ev = Clock::events.top();
+    Clock::events.pop();
+    if (ev.deadline > Clock::virtual_nanos) Clock::virtual_nanos = ev.deadline;
+    ev.fn(ev.context, ev.tag);
+  }
+  Clock::dispatching = false;
+}
+
+void Clock::advance(uint64_t deadline) {
+  // Delays inside an event handler just consume time
+  if (!Clock::dispatching) Clock::dispatch(deadline);
+  if (deadline > Clock::virtual_nanos) Clock::virtual_nanos = deadline;
+}
+
+void Clock::idle() {
+  if (Clock::dispatching) return;
+  Clock::advance(Clock::events.empty() ? Clock::virtual_nanos + 1000000ULL : Clock::events.top().deadline);
+}
+
 #endif // __PLAT_LINUX__
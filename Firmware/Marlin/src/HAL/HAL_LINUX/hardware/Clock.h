@@ -23,9 +23,13 @@
 
 #include <chrono>
 #include <thread>
+#include <queue>
+#include <vector>
 
 class Clock {
 public:
+  typedef void (event_fn)(void* context, uint32_t tag);
+
   static uint64_t ticks(uint32_t frequency = Clock::frequency) {
     return (Clock::nanos() - Clock::startup.count()) / (1000000000ULL / frequency);
   }
@@ -45,6 +49,7 @@ public:
 
   // Time Acceleration compensated
   static uint64_t nanos() {
+    if (Clock::virtual_time) return Clock::virtualNanos();
     auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
     return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
   }
@@ -61,19 +66,29 @@ public:
     return Clock::nanos() / 1000000000.0;
   }
 
+  // Host time in CPU cycles, for profiling. Never advances virtual time.
+  static uint32_t hostCycles() {
+    auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() / (1000000000ULL / Clock::frequency);
+  }
+
   static void delayCycles(uint64_t cycles) {
+    if (Clock::virtual_time) return Clock::advance(Clock::virtual_nanos + (1000000000L / frequency) * cycles);
     std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
   }
 
   static void delayMicros(uint64_t micros) {
+    if (Clock::virtual_time) return Clock::advance(Clock::virtual_nanos + micros * 1000ULL);
     std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
   }
 
   static void delayMillis(uint64_t millis) {
+    if (Clock::virtual_time) return Clock::advance(Clock::virtual_nanos + millis * 1000000ULL);
     std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
   }
 
   static void delaySeconds(double secs) {
+    if (Clock::virtual_time) return Clock::advance(Clock::virtual_nanos + uint64_t(secs * 1000000000.0));
     std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
   }
 
@@ -82,8 +97,59 @@ public:
     Clock::time_multiplier = tm;
   }
 
+  /**
+   * Discrete-event (fast-forward) mode
+   *
+   * Time no longer follows the wall clock. Timer deadlines are kept in a
+   * priority queue and time jumps straight to the next one whenever the
+   * firmware waits (idle(), delays). Every clock read costs one CPU cycle so
+   * busy-wait loops still terminate. Must be selected before any Timer is
+   * initialized, and all Clock access must then come from a single thread.
+   */
+  static void setVirtual(bool enable) {
+    Clock::virtual_time = enable;
+    Clock::virtual_nanos = 0;
+    if (enable) Clock::time_multiplier = 1.0;
+  }
+
+  static bool isVirtual() {
+    return Clock::virtual_time;
+  }
+
+  // Queue an event, 'tag' lets the owner recognize stale events
+  static void schedule(uint64_t deadline, event_fn* fn, void* context, uint32_t tag);
+
+  // Run all events due up to 'deadline' and move time there
+  static void advance(uint64_t deadline);
+
+  // Jump to the next pending event (or 1ms ahead when nothing is queued)
+  static void idle();
+
 private:
+  struct Event {
+    uint64_t deadline;
+    uint64_t sequence;
+    event_fn* fn;
+    void* context;
+    uint32_t tag;
+    bool operator>(const Event &rhs) const {
+      return deadline != rhs.deadline ? deadline > rhs.deadline : sequence > rhs.sequence;
+    }
+  };
+
+  static uint64_t virtualNanos() {
+    Clock::virtual_nanos += 1000000000ULL / Clock::frequency;
+    if (!Clock::dispatching) Clock::dispatch(Clock::virtual_nanos);
+    return Clock::virtual_nanos;
+  }
+
+  static void dispatch(uint64_t until);
+
   static std::chrono::nanoseconds startup;
   static uint32_t frequency;
   static double time_multiplier;
+
+  static bool virtual_time, dispatching;
+  static uint64_t virtual_nanos, event_sequence;
+  static std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
 };
@@ -38,6 +38,9 @@ LinearAxis::LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type en
   max_position = (200*80) + min_position;
   position = rand() % ((max_position - 40) - min_position) + (min_position + 20);
   last_update = Clock::nanos();
+  step_logger = nullptr;
+  axis_index = 0;
+  step_log_invert = false;
 
   Gpio::attachPeripheral(step_pin, this);
 
@@ -56,6 +59,7 @@ void LinearAxis::interrupt(GpioEvent ev) {
     if (ev.event == GpioEvent::RISE) {
       last_update = ev.timestamp;
       position += -1 + 2 * Gpio::pin_map[dir_pin].value;
+      if (step_logger) step_logger->log(axis_index, ev.timestamp, bool(Gpio::pin_map[dir_pin].value) != step_log_invert);
       Gpio::pin_map[min_pin].value = (position < min_position);
       //Gpio::pin_map[max_pin].value = (position > max_position);
       //if (position < min_position) printf("axis(%d) endstop : pos: %d, mm: %f, min: %d\n", step_pin, position, position / 80.0, Gpio::pin_map[min_pin].value);
@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include "Gpio.h"
+#include "StepLogger.h"
 
 class LinearAxis: public Peripheral {
 public:
@@ -30,6 +31,11 @@ public:
   virtual ~LinearAxis();
   void update();
   void interrupt(GpioEvent ev);
+  void attachStepLogger(StepLogger* logger, uint8_t axis, bool invert_dir) {
+    step_logger = logger;
+    axis_index = axis;
+    step_log_invert = invert_dir;
+  }
 
   pin_type enable_pin;
   pin_type dir_pin;
@@ -42,4 +48,8 @@ public:
   int32_t max_position;
   uint64_t last_update;
 
+  StepLogger* step_logger;
+  uint8_t axis_index;
+  bool step_log_invert;
+
 };
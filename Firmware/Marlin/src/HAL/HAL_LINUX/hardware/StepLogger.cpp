@@ -0,0 +1,68 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "StepLogger.h"
+
+StepLogger::StepLogger(std::string filename, uint8_t axis_count, const char *names, const float *steps_per_mm) {
+  last_timestamp = 0;
+  used = 0;
+  file = fopen(filename.c_str(), "wb");
+  if (!file) return;
+  const uint8_t header[6] = { 'M', 'S', 'T', 'P', STEP_LOG_VERSION, axis_count };
+  fwrite(header, 1, sizeof(header), file);
+  for (uint8_t i = 0; i < axis_count; i++) {
+    fwrite(&names[i], 1, 1, file);
+    fwrite(&steps_per_mm[i], sizeof(float), 1, file);
+  }
+}
+
+StepLogger::~StepLogger() {
+  if (!file) return;
+  flush();
+  fclose(file);
+}
+
+void StepLogger::put(uint32_t delta, uint8_t flags) {
+  if (used + 5 > sizeof(buffer)) flush();
+  uint8_t *rec = &buffer[used];
+  rec[0] = delta; rec[1] = delta >> 8; rec[2] = delta >> 16; rec[3] = delta >> 24;
+  rec[4] = flags;
+  used += 5;
+}
+
+void StepLogger::log(uint8_t axis, uint64_t timestamp, bool forward) {
+  if (!file) return;
+  uint64_t delta = timestamp > last_timestamp ? timestamp - last_timestamp : 0;
+  last_timestamp += delta;
+  for (; delta > UINT32_MAX; delta -= UINT32_MAX) put(UINT32_MAX, STEP_LOG_GAP);
+  put(delta, (axis & 0x7F) | (forward ? 0x80 : 0));
+}
+
+void StepLogger::flush() {
+  if (!file) return;
+  fwrite(buffer, 1, used, file);
+  used = 0;
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,61 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+/**
+ * Compact binary step recorder
+ *
+ * File layout (little-endian):
+ *   header : "MSTP", uint8 version, uint8 axis count,
+ *            then per axis: char name, float steps per mm
+ *   records: uint32 ns since the previous record,
+ *            uint8 axis (bits 0-6) | forward direction (bit 7)
+ *
+ * An axis value of STEP_LOG_GAP marks a record that only carries time,
+ * used when two steps are more than a uint32 of nanoseconds apart.
+ * Records are buffered and written in large chunks, never flushed per step.
+ * The file is only complete once the logger is deleted at shutdown.
+ */
+
+#define STEP_LOG_VERSION 1
+#define STEP_LOG_GAP     0x7F
+
+class StepLogger {
+public:
+  StepLogger(std::string filename, uint8_t axis_count, const char *names, const float *steps_per_mm);
+  virtual ~StepLogger();
+  bool isOpen() { return file != nullptr; }
+  void log(uint8_t axis, uint64_t timestamp, bool forward);
+
+private:
+  void put(uint32_t delta, uint8_t flags);
+  void flush();
+
+  FILE *file;
+  uint64_t last_timestamp;
+  uint32_t used;
+  uint8_t buffer[5 * 8192];
+};
@@ -27,6 +27,8 @@
 
 Timer::Timer() {
   active = false;
+  pending = false;
+  generation = 0;
   compare = 0;
   frequency = 0;
   overruns = 0;
@@ -38,7 +40,7 @@ Timer::Timer() {
 }
 
 Timer::~Timer() {
-  timer_delete(timerid);
+  if (!Clock::isVirtual()) timer_delete(timerid);
 }
 
 void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
@@ -48,6 +50,8 @@ void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
   frequency = sim_freq;
   cbfn = fn;
 
+  if (Clock::isVirtual()) return; // Clock schedules the events, no signals needed
+
   sa.sa_flags = SA_SIGINFO;
   sa.sa_sigaction = Timer::handler;
   sigemptyset(&sa.sa_mask);
@@ -74,6 +78,14 @@ void Timer::start(uint32_t frequency) {
 }
 
 void Timer::enable() {
+  if (Clock::isVirtual()) {
+    active = true;
+    if (pending) { // deliver the interrupt that was flagged while masked
+      pending = false;
+      Clock::schedule(Clock::nanos(), Timer::event, this, generation);
+    }
+    return;
+  }
   if (sigprocmask(SIG_UNBLOCK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
@@ -82,6 +94,10 @@ void Timer::enable() {
 }
 
 void Timer::disable() {
+  if (Clock::isVirtual()) {
+    active = false;
+    return;
+  }
   if (sigprocmask(SIG_SETMASK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
@@ -89,6 +105,12 @@ void Timer::disable() {
 }
 
 void Timer::setCompare(uint32_t compare) {
+  if (Clock::isVirtual()) {
+    this->compare = compare;
+    this->start_time = Clock::nanos();
+    arm(this->start_time);
+    return;
+  }
   uint32_t nsec_offset = 0;
   if (active) {
     nsec_offset = Clock::nanos() - this->start_time; // calculate how long the timer would have been running for
@@ -111,6 +133,28 @@ void Timer::setCompare(uint32_t compare) {
   this->start_time = Clock::nanos();
 }
 
+/**
+ * Queue the next expiry 'compare' ticks after 'from'. Bumping the generation
+ * turns any previously queued expiry of this timer into a no-op.
+ */
+void Timer::arm(uint64_t from) {
+  period = Clock::ticksToNanos(compare, frequency);
+  if (period < 1) period = 1;
+  Clock::schedule(from + period, Timer::event, this, ++generation);
+}
+
+void Timer::event(void* context, uint32_t tag) {
+  Timer* _this = (Timer*)context;
+  if (tag != _this->generation) return; // re-armed since this was queued
+  const uint64_t now = Clock::nanos();
+  _this->start_time = now;
+  _this->arm(now); // periodic, like it_interval
+  if (_this->active)
+    _this->cbfn();
+  else
+    _this->pending = true;
+}
+
 uint32_t Timer::getCount() {
   return Clock::nanosToTicks(Clock::nanos() - this->start_time, frequency);
 }
@@ -62,8 +62,15 @@ public:
                                                          // using a realtime linux kernel would help somewhat
   }
 
+  // Discrete-event counterpart of handler(), called by Clock::dispatch()
+  static void event(void* context, uint32_t tag);
+
 private:
+  void arm(uint64_t deadline);
+
   bool active;
+  bool pending;
+  uint32_t generation;
   uint32_t compare;
   uint32_t frequency;
   uint32_t overruns;
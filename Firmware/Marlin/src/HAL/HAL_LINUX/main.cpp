@@ -22,8 +22,13 @@
 
 extern void setup();
 extern void loop();
+extern int planner_bench(const char * const corpus);
 
 #include <thread>
+#include <atomic>
+#include <csignal>
+#include <poll.h>
+#include <cerrno>
 
 #include <iostream>
 #include <fstream>
@@ -35,50 +40,99 @@ extern void loop();
 #include "hardware/IOLoggerCSV.h"
 #include "hardware/Heater.h"
 #include "hardware/LinearAxis.h"
+#include "hardware/Timer.h"
+#include "hardware/StepLogger.h"
+#include "../../gcode/queue.h"
+#include "../../module/planner.h"
+
+// Cleared to stop the helper threads at shutdown
+static std::atomic<bool> threads_running(true);
 
 // simple stdout / stdin implementation for fake serial port
 void write_serial_thread() {
   for (;;) {
+    const bool running = threads_running;
     for (std::size_t i = usb_serial.transmit_buffer.available(); i > 0; i--) {
       fputc(usb_serial.transmit_buffer.read(), stdout);
     }
+    if (!running) break; // Everything sent before the stop is written
     std::this_thread::yield();
   }
+  fflush(stdout);
 }
 
 void read_serial_thread() {
   char buffer[255] = {};
-  for (;;) {
+  setvbuf(stdin, nullptr, _IONBF, 0); // Nothing buffered that poll() can't see
+  pollfd pfd = { fileno(stdin), POLLIN, 0 };
+  while (threads_running) {
     std::size_t len = _MIN(usb_serial.receive_buffer.free(), 254U);
-    if (fgets(buffer, len, stdin))
-      for (std::size_t i = 0; i < strlen(buffer); i++)
-        usb_serial.receive_buffer.write(buffer[i]);
+    // Wait a little at a time so the thread can be stopped
+    if (len < 2 || poll(&pfd, 1, 100) <= 0) { std::this_thread::yield(); continue; }
+    if (!fgets(buffer, len, stdin)) {
+      if (feof(stdin)) break;
+      clearerr(stdin); // Interrupted by a signal
+      continue;
+    }
+    for (std::size_t i = 0; i < strlen(buffer); i++)
+      usb_serial.receive_buffer.write(buffer[i]);
     std::this_thread::yield();
   }
 }
 
-void simulation_loop() {
-  Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
-  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
-  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
-  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
-  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
-  LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
+// In fast-forward mode stdin is read synchronously, so each line
+// reaches the firmware at the same simulated time on every run
+static bool input_finished = false;
 
-  //#define GPIO_LOGGING // Full GPIO and Positional Logging
+void read_serial_sync() {
+  while (!input_finished && usb_serial.receive_buffer.free()) {
+    const int c = fgetc(stdin);
+    if (c == EOF) {
+      if (ferror(stdin) && errno == EINTR) { clearerr(stdin); break; } // Stopped by a signal
+      input_finished = true;
+      break;
+    }
+    usb_serial.receive_buffer.write(c);
+    if (c == '\n') break;
+  }
+}
 
-  #ifdef GPIO_LOGGING
-    IOLoggerCSV logger("all_gpio_log.csv");
-    Gpio::attachLogger(&logger);
+// Optional recorders, selected on the command line
+static std::string gpio_log_file, step_log_file, bench_file;
 
-    std::ofstream position_log;
-    position_log.open("axis_position_log.csv");
+class Simulation {
+public:
+  Simulation() :
+    hotend(HEATER_0_PIN, TEMP_0_PIN),
+    bed(HEATER_BED_PIN, TEMP_BED_PIN),
+    x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN),
+    y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN),
+    z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN),
+    extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC),
+    gpio_logger(nullptr), step_logger(nullptr)
+  {
+    // Full GPIO log, text CSV of every pin event
+    if (!gpio_log_file.empty()) {
+      gpio_logger = new IOLoggerCSV(gpio_log_file);
+      Gpio::attachLogger(gpio_logger);
+    }
 
-    int32_t x,y,z;
-  #endif
+    // Binary step log, see StepLogger.h. Directions are logged in machine space.
+    if (!step_log_file.empty()) {
+      const float steps_per_mm[] = DEFAULT_AXIS_STEPS_PER_UNIT;
+      step_logger = new StepLogger(step_log_file, 4, "XYZE", steps_per_mm);
+      x_axis.attachStepLogger(step_logger, 0, INVERT_X_DIR);
+      y_axis.attachStepLogger(step_logger, 1, INVERT_Y_DIR);
+      z_axis.attachStepLogger(step_logger, 2, INVERT_Z_DIR);
+      extruder0.attachStepLogger(step_logger, 3, INVERT_E0_DIR);
+    }
+  }
 
-  for (;;) {
+  ~Simulation() {
+    finish();
+  }
 
+  void update() {
     hotend.update();
     bed.update();
 
@@ -87,26 +141,118 @@ void simulation_loop() {
     z_axis.update();
     extruder0.update();
 
-    #ifdef GPIO_LOGGING
-      if (x_axis.position != x || y_axis.position != y || z_axis.position != z) {
-        uint64_t update = MAX3(x_axis.last_update, y_axis.last_update, z_axis.last_update);
-        position_log << update << ", " << x_axis.position << ", " << y_axis.position << ", " << z_axis.position << std::endl;
-        position_log.flush();
-        x = x_axis.position;
-        y = y_axis.position;
-        z = z_axis.position;
-      }
-      // flush the logger
-      logger.flush();
-    #endif
+    if (gpio_logger) gpio_logger->flush();
+  }
 
+  // Write out everything still buffered by the recorders. Called once
+  // the interrupts are stopped, so no more steps or pin events come in.
+  void finish() {
+    if (gpio_logger) {
+      Gpio::attachLogger(nullptr);
+      gpio_logger->flush();
+      delete gpio_logger;
+      gpio_logger = nullptr;
+    }
+    if (step_logger) {
+      x_axis.attachStepLogger(nullptr, 0, false);
+      y_axis.attachStepLogger(nullptr, 0, false);
+      z_axis.attachStepLogger(nullptr, 0, false);
+      extruder0.attachStepLogger(nullptr, 0, false);
+      delete step_logger;
+      step_logger = nullptr;
+    }
+  }
+
+  Heater hotend, bed;
+  LinearAxis x_axis, y_axis, z_axis, extruder0;
+  IOLoggerCSV* gpio_logger;
+  StepLogger* step_logger;
+};
+
+static Simulation *simulation_instance = nullptr;
+
+void simulation_loop() {
+  while (threads_running) {
+    simulation_instance->update();
     std::this_thread::yield();
   }
 }
 
-int main() {
-  std::thread write_serial (write_serial_thread);
-  std::thread read_serial (read_serial_thread);
+// Fast-forward mode steps the simulated hardware from a timer event instead of a thread
+static Timer simulation_timer;
+void simulation_tick() { simulation_instance->update(); }
+
+// Ctrl-C or SIGTERM asks for a normal shutdown, done outside the handler
+static volatile sig_atomic_t exit_requested = 0;
+void simulation_exit(int) { exit_requested = 1; }
+
+static std::thread write_serial, read_serial, simulation;
+
+// Stop the interrupts and threads and write out the recorders
+static void simulation_shutdown() {
+  HAL_timer_disable_interrupt(STEP_TIMER_NUM);
+  HAL_timer_disable_interrupt(TEMP_TIMER_NUM);
+  if (Clock::isVirtual()) simulation_timer.disable();
+
+  SERIAL_FLUSHTX();
+  threads_running = false;
+  if (simulation.joinable()) simulation.join();
+  if (read_serial.joinable()) read_serial.join();
+  if (write_serial.joinable()) write_serial.join();
+
+  simulation_instance->finish();
+  if (Clock::isVirtual()) fprintf(stderr, "Simulated time: %.6fs\n", Clock::seconds());
+  delete simulation_instance;
+  simulation_instance = nullptr;
+}
+
+void HAL_idletask() {
+  if (Clock::isVirtual()) {
+    read_serial_sync();
+    Clock::idle(); // nothing else to do until the next timer event
+  }
+  // A stop requested while the firmware waits in idle()
+  if (exit_requested) {
+    simulation_shutdown();
+    exit(0);
+  }
+}
+
+static void print_usage(const char * const name) {
+  fprintf(stderr, "Usage: %s [--fast-forward] [--step-log FILE] [--gpio-log FILE] [--planner-bench FILE]\n"
+                  "  --fast-forward    Discrete-event time: run as fast as possible with a\n"
+                  "                    reproducible step timing; exit once stdin is consumed\n"
+                  "                    and all moves are complete.\n"
+                  "  --step-log FILE   Record every step in compact binary form, see\n"
+                  "                    buildroot/share/scripts/step_profile.py\n"
+                  "  --gpio-log FILE   Record every GPIO event as CSV (slow)\n"
+                  "  --planner-bench FILE\n"
+                  "                    Time Planner::buffer_line over the moves of a G-code\n"
+                  "                    file in fast-forward mode, report to stderr and exit.\n"
+                  "                    See buildroot/share/scripts/planner_bench.py\n", name);
+}
+
+int main(int argc, char *argv[]) {
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--fast-forward"))
+      Clock::setVirtual(true);
+    else if (!strcmp(argv[i], "--step-log") && i + 1 < argc)
+      step_log_file = argv[++i];
+    else if (!strcmp(argv[i], "--gpio-log") && i + 1 < argc)
+      gpio_log_file = argv[++i];
+    else if (!strcmp(argv[i], "--planner-bench") && i + 1 < argc) {
+      bench_file = argv[++i];
+      Clock::setVirtual(true);
+      input_finished = true; // stdin is not used
+    }
+    else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  write_serial = std::thread(write_serial_thread);
+  if (!Clock::isVirtual()) read_serial = std::thread(read_serial_thread);
 
   #if NUM_SERIAL > 0
     MYSERIAL0.begin(BAUDRATE);
@@ -115,23 +261,44 @@ int main() {
   #endif
 
   Clock::setFrequency(F_CPU);
-  Clock::setTimeMultiplier(1.0); // some testing at 10x
+  if (!Clock::isVirtual()) Clock::setTimeMultiplier(1.0); // some testing at 10x
 
   HAL_timer_init();
 
-  std::thread simulation (simulation_loop);
+  simulation_instance = new Simulation();
+  // No SA_RESTART, so a blocking read of stdin returns to check for the stop
+  struct sigaction sa = {};
+  sa.sa_handler = simulation_exit;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGINT, &sa, nullptr);
+  sigaction(SIGTERM, &sa, nullptr);
+
+  if (Clock::isVirtual()) {
+    simulation_timer.init(2, 1000000, simulation_tick);
+    simulation_timer.start(2000);
+    simulation_timer.enable();
+  }
+  else
+    simulation = std::thread(simulation_loop);
 
   DELAY_US(10000);
 
   setup();
-  for (;;) {
+
+  int status = 0;
+  if (!bench_file.empty())
+    status = planner_bench(bench_file.c_str());
+  else while (!exit_requested) {
     loop();
-    std::this_thread::yield();
+    if (Clock::isVirtual()) {
+      if (input_finished && !usb_serial.available() && !queue.has_commands_queued() && !planner.has_blocks_queued()) break;
+    }
+    else
+      std::this_thread::yield();
   }
 
-  simulation.join();
-  write_serial.join();
-  read_serial.join();
+  simulation_shutdown();
+  return status;
 }
 
 #endif // __PLAT_LINUX__
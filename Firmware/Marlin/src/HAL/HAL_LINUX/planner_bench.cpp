@@ -0,0 +1,154 @@
+/**
+ * Marlin 3D Printer Firmware
+ *
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Planner benchmark
+ *
+ * Feeds the G0/G1 moves of a G-code file straight into Planner::buffer_line,
+ * timing every call with the host clock while the Stepper ISR drains the
+ * buffer in fast-forward time. G90/G91, M82/M83 and G92 are followed; all
+ * other commands are ignored. The report goes to stderr, one "key: values"
+ * line per figure, for buildroot/share/scripts/planner_bench.py.
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "../../inc/MarlinConfig.h"
+#include "../../MarlinCore.h"
+#include "../../module/motion.h"
+#include "../../module/planner.h"
+#include "../../module/temperature.h"
+#include "../../gcode/parser.h"
+#include "hardware/Clock.h"
+
+#if HAS_LEVELING
+  #include "../../feature/bedlevel/bedlevel.h"
+#endif
+
+int planner_bench(const char * const corpus) {
+  std::ifstream in(corpus);
+  if (!in) {
+    fprintf(stderr, "%s: cannot open\n", corpus);
+    return 1;
+  }
+
+  // Plain moves only: no leveling, no temperature gate on E
+  #if HAS_LEVELING
+    set_bed_leveling_enabled(false);
+  #endif
+  #if ENABLED(PREVENT_COLD_EXTRUSION)
+    thermalManager.allow_cold_extrude = true;
+  #endif
+  sync_plan_position();
+
+  #if ENABLED(PLANNER_STATS)
+    planner.reset_stats();
+  #endif
+
+  std::vector<uint32_t> call_ns;
+  uint32_t moves = 0, blocks = 0;
+  bool relative_xyz = false, relative_e = false;
+  feedRate_t fr_mm_s = MMM_TO_MMS(1500);
+  const double start_seconds = Clock::seconds();
+
+  std::string line;
+  while (std::getline(in, line)) {
+    line.erase(std::min(line.find(';'), line.size()));
+    if (line.empty()) continue;
+    parser.parse(&line[0]);
+
+    if (parser.command_letter == 'M') {
+      if (parser.codenum == 82) relative_e = false;
+      else if (parser.codenum == 83) relative_e = true;
+      continue;
+    }
+    if (parser.command_letter != 'G') continue;
+
+    switch (parser.codenum) {
+      case 90: relative_xyz = relative_e = false; continue;
+      case 91: relative_xyz = relative_e = true; continue;
+      case 92:
+        LOOP_XYZE(i) if (parser.seenval(axis_codes[i])) current_position[i] = parser.value_float();
+        sync_plan_position();
+        continue;
+      case 0: case 1: break;
+      default: continue;
+    }
+
+    destination = current_position;
+    LOOP_XYZE(i) if (parser.seenval(axis_codes[i])) {
+      const bool relative = i == E_AXIS ? relative_e : relative_xyz;
+      destination[i] = (relative ? current_position[i] : 0) + parser.value_float();
+    }
+    if (parser.seenval('F')) fr_mm_s = parser.value_feedrate();
+
+    // Let the Stepper ISR make room first, so only the planning is timed.
+    // A call may queue two blocks if it flushes a run of coalesced moves.
+    while (planner.moves_free() < 2) idle();
+
+    const uint8_t head = planner.block_buffer_head;
+    const auto t0 = std::chrono::steady_clock::now();
+    planner.buffer_line(destination, fr_mm_s, active_extruder);
+    const auto t1 = std::chrono::steady_clock::now();
+    if (planner.block_buffer_head != head) {
+      blocks += BLOCK_MOD(planner.block_buffer_head - head);
+      call_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
+    current_position = destination;
+    moves++;
+  }
+
+  planner.synchronize();
+
+  const double motion_seconds = Clock::seconds() - start_seconds;
+  uint64_t total_ns = 0;
+  for (const uint32_t ns : call_ns) total_ns += ns;
+  std::sort(call_ns.begin(), call_ns.end());
+  const auto percentile = [&](const float p) {
+    return call_ns.empty() ? 0.0f : call_ns[std::min(call_ns.size() - 1, size_t(call_ns.size() * p))] / 1000.0f;
+  };
+
+  fprintf(stderr, "corpus: %s\n", corpus);
+  fprintf(stderr, "moves: %u\n", moves);
+  fprintf(stderr, "blocks: %u\n", blocks);
+  fprintf(stderr, "block_buffer_size: %u\n", BLOCK_BUFFER_SIZE);
+  fprintf(stderr, "blocks_per_second: %.0f\n", total_ns ? blocks * 1e9 / total_ns : 0.0);
+  fprintf(stderr, "buffer_line_us: %.3f %.3f %.3f %.3f\n",  // mean, median, p99, max
+    blocks ? total_ns / 1000.0 / blocks : 0.0, percentile(0.5f), percentile(0.99f), percentile(1.0f));
+  fprintf(stderr, "motion_us_per_block: %.1f\n", blocks ? motion_seconds * 1e6 / blocks : 0.0);
+  #if ENABLED(PLANNER_STATS)
+    const planner_stats_t &s = planner.stats;
+    const float per = s.recalcs ? 1.0f / s.recalcs : 0.0f;
+    fprintf(stderr, "recalcs: %u\n", s.recalcs);
+    fprintf(stderr, "reverse_pass: %.2f %u\n", s.reverse_visits * per, s.reverse_max);     // mean, max blocks visited
+    fprintf(stderr, "forward_pass: %.2f %u\n", s.forward_visits * per, s.forward_max);
+    fprintf(stderr, "trapezoid_pass: %.2f %u\n", s.trapezoid_visits * per, s.trapezoid_max);
+    fprintf(stderr, "trapezoids: %.2f\n", s.trapezoids * per);                               // mean computed per recalculate()
+  #endif
+  return 0;
+}
+
+#endif // __PLAT_LINUX__
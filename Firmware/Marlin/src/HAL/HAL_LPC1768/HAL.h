@@ -125,6 +125,17 @@ extern "C" volatile uint32_t _millis;
 #define ENABLE_ISRS()  __enable_irq()
 #define DISABLE_ISRS() __disable_irq()
 
+//
+// Cycle counter (DWT)
+//
+#define HAS_CYCLE_COUNTER 1
+[[gnu::always_inline]] inline void HAL_cycle_counter_init() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+[[gnu::always_inline]] inline uint32_t HAL_cycle_count() { return DWT->CYCCNT; }
+
 //
 // Utility functions
 //
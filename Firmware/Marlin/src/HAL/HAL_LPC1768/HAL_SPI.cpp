@@ -94,6 +94,11 @@
       (void)spiTransfer(buf[i]);
   }
 
+  #if ENABLED(SD_READ_AHEAD)
+    void spiReadStart(uint8_t* buf, uint16_t nbyte) { spiRead(buf, nbyte); }
+    bool spiReadBusy() { return false; }
+  #endif
+
 #else
 
   // Hardware SPI
@@ -209,6 +214,63 @@
 
   }
 
+  #if ENABLED(SD_READ_AHEAD)
+
+    /**
+     * Background reads by GPDMA: one channel feeds the SSP from the buffer,
+     * filled with 0xFF first, and the other puts the received bytes back in
+     * behind it. The GPDMA can only reach the AHB SRAM banks, not the local
+     * SRAM at 0x10000000, so a buffer there is read right away.
+     */
+    #define SPI_DMA_RX LPC_GPDMACH6                 // The lower channel has the higher priority
+    #define SPI_DMA_TX LPC_GPDMACH7
+    #define SPI_DMA_RX_REQ (LPC_HW_SPI_DEV == 0 ? 1 : 3) // SSP0/1 Rx request line
+    #define SPI_DMA_TX_REQ (LPC_HW_SPI_DEV == 0 ? 0 : 2) // SSP0/1 Tx request line
+    #define SPI_DMA_AHB_SRAM 0x2007C000UL
+
+    void spiReadStart(uint8_t* buf, uint16_t nbyte) {
+      if (uint32_t(buf) < SPI_DMA_AHB_SRAM || nbyte > 0xFFF) {
+        spiRead(buf, nbyte);
+        return;
+      }
+
+      if (!(LPC_GPDMA->DMACConfig & 1)) {
+        CLKPWR_ConfigPPWR(CLKPWR_PCONP_PCGPDMA, ENABLE);
+        LPC_GPDMA->DMACConfig = 1;                  // Enable, little-endian
+      }
+
+      while (SSP_GetStatus(LPC_SSPn, SSP_STAT_BUSY)) { /* nada */ }
+      while (SSP_GetStatus(LPC_SSPn, SSP_STAT_RXFIFO_NOTEMPTY)) (void)LPC_SSPn->DR; // Drop stale bytes
+
+      memset(buf, 0xFF, nbyte);
+
+      LPC_GPDMA->DMACIntTCClear = _BV(6) | _BV(7);
+      LPC_GPDMA->DMACIntErrClr = _BV(6) | _BV(7);
+
+      SPI_DMA_RX->DMACCSrcAddr = uint32_t(&LPC_SSPn->DR);
+      SPI_DMA_RX->DMACCDestAddr = uint32_t(buf);
+      SPI_DMA_RX->DMACCLLI = 0;
+      SPI_DMA_RX->DMACCControl = nbyte | _BV(27);   // Single bytes, increment the destination
+      SPI_DMA_RX->DMACCConfig = 1 | (SPI_DMA_RX_REQ << 1) | (2 << 11); // Enable, peripheral to memory
+
+      SPI_DMA_TX->DMACCSrcAddr = uint32_t(buf);
+      SPI_DMA_TX->DMACCDestAddr = uint32_t(&LPC_SSPn->DR);
+      SPI_DMA_TX->DMACCLLI = 0;
+      SPI_DMA_TX->DMACCControl = nbyte | _BV(26);   // Single bytes, increment the source
+      SPI_DMA_TX->DMACCConfig = 1 | (SPI_DMA_TX_REQ << 6) | (1 << 11); // Enable, memory to peripheral
+
+      LPC_SSPn->DMACR = 0x03;                       // Rx and Tx DMA requests on
+    }
+
+    bool spiReadBusy() {
+      if (!LPC_SSPn->DMACR) return false;           // Read right away
+      if (SPI_DMA_RX->DMACCConfig & 1) return true; // The Rx channel disables itself when done
+      LPC_SSPn->DMACR = 0;
+      return false;
+    }
+
+  #endif // SD_READ_AHEAD
+
 #endif // ENABLED(LPC_SOFTWARE_SPI)
 
 void SPIClass::begin() { spiBegin(); }
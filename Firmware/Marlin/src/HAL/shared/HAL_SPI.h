@@ -79,6 +79,13 @@ void spiSendBlock(uint8_t token, const uint8_t* buf);
 // Begin SPI transaction, set clock, bit order, data mode
 void spiBeginTransaction(uint32_t spiClock, uint8_t bitOrder, uint8_t dataMode);
 
+#if ENABLED(SD_READ_AHEAD)
+  // Read from SPI into buffer in the background, if possible
+  void spiReadStart(uint8_t* buf, uint16_t nbyte);
+  // Is the spiReadStart() transfer still going?
+  bool spiReadBusy();
+#endif
+
 //
 // Extended SPI functions taking a channel number (Hardware SPI only)
 //
@@ -177,6 +177,14 @@
   #include "feature/prusa_MMU2/mmu2.h"
 #endif
 
+#if ENABLED(STEPPER_ISR_PROFILE)
+  #include "feature/isr_profile.h"
+#endif
+
+#if ENABLED(BUFFER_MONITORING)
+  #include "feature/buffer_monitor.h"
+#endif
+
 #if HAS_L64XX
   #include "libs/L64XX/L64XX_Marlin.h"
 #endif
@@ -436,7 +444,7 @@ void manage_inactivity(const bool ignore_stepper_queue/*=false*/) {
     runout.run();
   #endif
 
-  if (queue.length < BUFSIZE) queue.get_available_commands();
+  if (!queue.full()) queue.get_available_commands();
 
   const millis_t ms = millis();
 
@@ -654,6 +662,14 @@ void idle(
     max7219.idle_tasks();
   #endif
 
+  #if ENABLED(SEGMENT_COALESCING)
+    planner.coalesce_idle();
+  #endif
+
+  #if ENABLED(STEP_SCHEDULE)
+    stepper.schedule_ahead();
+  #endif
+
   ui.update();
 
   #if ENABLED(HOST_KEEPALIVE_FEATURE)
@@ -699,9 +715,19 @@ void idle(
       #if ENABLED(AUTO_REPORT_SD_STATUS)
         card.auto_report_sd_status();
       #endif
+      #if ENABLED(STEPPER_ISR_PROFILE)
+        isr_profile.auto_report();
+      #endif
+      #if ENABLED(BUFFER_MONITORING)
+        buffer_monitor.auto_report();
+      #endif
     }
   #endif
 
+  #if ENABLED(BUFFER_MONITORING)
+    buffer_monitor.idle();
+  #endif
+
   #if ENABLED(USB_FLASH_DRIVE_SUPPORT)
     Sd2Card::idle();
   #endif
@@ -927,7 +953,11 @@ void setup() {
   #endif
 
   SERIAL_ECHO_START();
-  SERIAL_ECHOLNPAIR(MSG_FREE_MEMORY, freeMemory(), MSG_PLANNER_BUFFER_BYTES, (int)sizeof(block_t) * (BLOCK_BUFFER_SIZE));
+  SERIAL_ECHOLNPAIR(MSG_FREE_MEMORY, freeMemory(), MSG_PLANNER_BUFFER_BYTES, (int)sizeof(block_t) * (BLOCK_BUFFER_SIZE)
+    #if HAS_BLOCK_AUX
+      + (int)sizeof(block_aux_t) * (BLOCK_BUFFER_SIZE)
+    #endif
+  );
 
   // UI must be initialized before EEPROM
   // (because EEPROM code calls the UI).
@@ -970,6 +1000,10 @@ void setup() {
 
   endstops.init();          // Init endstops and pullups
 
+  #if ENABLED(STEPPER_ISR_PROFILE)
+    isr_profile.init();     // Start the cycle counter ahead of the Stepper ISR
+  #endif
+
   stepper.init();           // Init stepper. This enables interrupts!
 
   #if HAS_SERVOS
@@ -1144,6 +1178,12 @@ void loop() {
 
     queue.advance();
 
+    #if ENABLED(BUFFER_MONITORING)
+      // Short of moves? Run the commands already read before the next idle()
+      for (uint8_t n = BUFSIZE - 1; n && queue.length && buffer_monitor.starving(); --n)
+        queue.advance();
+    #endif
+
     endstops.event_handler();
 
   } while (false        // Return to caller for best compatibility
@@ -146,22 +146,11 @@ void print_bilinear_leveling_grid() {
   );
 }
 
-#if ENABLED(ABL_BILINEAR_SUBDIVISION)
+#if EITHER(ABL_BILINEAR_SUBDIVISION, ABL_BICUBIC)
 
-  #define ABL_GRID_POINTS_VIRT_X (GRID_MAX_POINTS_X - 1) * (BILINEAR_SUBDIVISIONS) + 1
-  #define ABL_GRID_POINTS_VIRT_Y (GRID_MAX_POINTS_Y - 1) * (BILINEAR_SUBDIVISIONS) + 1
+  // The probed grid with a border of points extrapolated from the edges
   #define ABL_TEMP_POINTS_X (GRID_MAX_POINTS_X + 2)
   #define ABL_TEMP_POINTS_Y (GRID_MAX_POINTS_Y + 2)
-  float z_values_virt[ABL_GRID_POINTS_VIRT_X][ABL_GRID_POINTS_VIRT_Y];
-  xy_pos_t bilinear_grid_spacing_virt;
-  xy_float_t bilinear_grid_factor_virt;
-
-  void print_bilinear_leveling_grid_virt() {
-    SERIAL_ECHOLNPGM("Subdivided with CATMULL ROM Leveling Grid:");
-    print_2d_array(ABL_GRID_POINTS_VIRT_X, ABL_GRID_POINTS_VIRT_Y, 5,
-      [](const uint8_t ix, const uint8_t iy) { return z_values_virt[ix][iy]; }
-    );
-  }
 
   #define LINEAR_EXTRAPOLATION(E, I) ((E) * 2 - (I))
   float bed_level_virt_coord(const uint8_t x, const uint8_t y) {
@@ -201,6 +190,23 @@ void print_bilinear_leveling_grid() {
     return z_values[x - 1][y - 1];
   }
 
+#endif
+
+#if ENABLED(ABL_BILINEAR_SUBDIVISION)
+
+  #define ABL_GRID_POINTS_VIRT_X (GRID_MAX_POINTS_X - 1) * (BILINEAR_SUBDIVISIONS) + 1
+  #define ABL_GRID_POINTS_VIRT_Y (GRID_MAX_POINTS_Y - 1) * (BILINEAR_SUBDIVISIONS) + 1
+  float z_values_virt[ABL_GRID_POINTS_VIRT_X][ABL_GRID_POINTS_VIRT_Y];
+  xy_pos_t bilinear_grid_spacing_virt;
+  xy_float_t bilinear_grid_factor_virt;
+
+  void print_bilinear_leveling_grid_virt() {
+    SERIAL_ECHOLNPGM("Subdivided with CATMULL ROM Leveling Grid:");
+    print_2d_array(ABL_GRID_POINTS_VIRT_X, ABL_GRID_POINTS_VIRT_Y, 5,
+      [](const uint8_t ix, const uint8_t iy) { return z_values_virt[ix][iy]; }
+    );
+  }
+
   static float bed_level_virt_cmr(const float p[4], const uint8_t i, const float t) {
     return (
         p[i-1] * -t * sq(1 - t)
@@ -241,14 +247,6 @@ void print_bilinear_leveling_grid() {
   }
 #endif // ABL_BILINEAR_SUBDIVISION
 
-// Refresh after other values have been updated
-void refresh_bed_level() {
-  bilinear_grid_factor = bilinear_grid_spacing.reciprocal();
-  #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-    bed_level_virt_interpolate();
-  #endif
-}
-
 #if ENABLED(ABL_BILINEAR_SUBDIVISION)
   #define ABL_BG_SPACING(A) bilinear_grid_spacing_virt.A
   #define ABL_BG_FACTOR(A)  bilinear_grid_factor_virt.A
@@ -263,158 +261,231 @@ void refresh_bed_level() {
   #define ABL_BG_GRID(X,Y)  z_values[X][Y]
 #endif
 
-// Get the Z adjustment for non-linear bed leveling
-float bilinear_z_offset(const xy_pos_t &raw) {
-
-  static float z1, d2, z3, d4, L, D;
+#define ABL_BG_CELLS_X (ABL_BG_POINTS_X - 1)
+#define ABL_BG_CELLS_Y (ABL_BG_POINTS_Y - 1)
 
-  static xy_pos_t prev { -999.999, -999.999 }, ratio;
+#if ENABLED(ABL_BICUBIC)
 
-  // Whole units for the grid line indices. Constrained within bounds.
-  static xy_int8_t thisg, nextg, lastg { -99, -99 };
+  /**
+   * Bicubic (Catmull-Rom) patch coefficients of a grid cell, so that
+   * within the cell Z = sum of a[i][j] * rx^i * ry^j, with rx / ry the
+   * position within the cell as a ratio of the grid spacing.
+   *
+   * Patches are made from the probed points when first needed and kept
+   * in a small cache, most recently used first.
+   */
+  typedef struct {
+    volatile int16_t key;                   // Cell X * 256 + Y, or -1 if unused
+    float a[4][4];
+  } bicubic_cell_t;
 
-  // XY relative to the probed area
-  xy_pos_t rel = raw - bilinear_start.asFloat();
+  static bicubic_cell_t bicubic_cells[ABL_BICUBIC_CACHE];
+  static uint8_t bicubic_order[ABL_BICUBIC_CACHE];  // Indexes into bicubic_cells, most recent first
 
-  #if ENABLED(EXTRAPOLATE_BEYOND_GRID)
-    #define FAR_EDGE_OR_BOX 2   // Keep using the last grid box
-  #else
-    #define FAR_EDGE_OR_BOX 1   // Just use the grid far edge
+  #if ENABLED(LEVELING_STREAM)
+    // The Stepper ISR only reads the shared cache, and keeps its own patch
+    static bicubic_cell_t bicubic_isr_cell;
   #endif
 
-  if (prev.x != rel.x) {
-    prev.x = rel.x;
-    ratio.x = rel.x * ABL_BG_FACTOR(x);
-    const float gx = constrain(FLOOR(ratio.x), 0, ABL_BG_POINTS_X - (FAR_EDGE_OR_BOX));
-    ratio.x -= gx;      // Subtract whole to get the ratio within the grid box
+  // Catmull-Rom spline through p[0..3] between p[1] and p[2], in powers of t
+  static constexpr float catmull_rom[4][4] = {
+    {  0.0f,  1.0f,  0.0f,  0.0f },
+    { -0.5f,  0.0f,  0.5f,  0.0f },
+    {  1.0f, -2.5f,  2.0f, -0.5f },
+    { -0.5f,  1.5f, -1.5f,  0.5f }
+  };
+
+  static void bicubic_make_patch(bicubic_cell_t &cell, const uint8_t x, const uint8_t y) {
+    float p[4][4], m[4][4];
+    LOOP_L_N(i, 4) LOOP_L_N(j, 4) p[i][j] = bed_level_virt_coord(x + i, y + j);
+    LOOP_L_N(i, 4) LOOP_L_N(j, 4) {
+      float sum = 0;
+      LOOP_L_N(k, 4) sum += catmull_rom[i][k] * p[k][j];
+      m[i][j] = sum;
+    }
+    LOOP_L_N(i, 4) LOOP_L_N(j, 4) {
+      float sum = 0;
+      LOOP_L_N(k, 4) sum += m[i][k] * catmull_rom[j][k];
+      cell.a[i][j] = sum;
+    }
+  }
 
-    #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
-      // Beyond the grid maintain height at grid edges
-      NOLESS(ratio.x, 0); // Never <0 (>1 is ok when nextg.x==thisg.x)
+  static const bicubic_cell_t& bicubic_patch(const uint8_t x, const uint8_t y, const bool from_isr) {
+    const int16_t key = (x << 8) | y;
+
+    #if ENABLED(LEVELING_STREAM)
+      if (from_isr) {
+        if (bicubic_isr_cell.key != key) {
+          uint8_t i = 0;
+          while (i < ABL_BICUBIC_CACHE && bicubic_cells[i].key != key) i++;
+          if (i < ABL_BICUBIC_CACHE)
+            bicubic_isr_cell = bicubic_cells[i];
+          else {
+            bicubic_make_patch(bicubic_isr_cell, x, y);
+            bicubic_isr_cell.key = key;
+          }
+        }
+        return bicubic_isr_cell;
+      }
+    #else
+      UNUSED(from_isr);
     #endif
 
-    thisg.x = gx;
-    nextg.x = _MIN(thisg.x + 1, ABL_BG_POINTS_X - 1);
-  }
-
-  if (prev.y != rel.y || lastg.x != thisg.x) {
+    // Look for the cell, or take the least recently used one
+    uint8_t o = 0;
+    while (o < ABL_BICUBIC_CACHE - 1 && bicubic_cells[bicubic_order[o]].key != key) o++;
+    const uint8_t index = bicubic_order[o];
+    bicubic_cell_t &cell = bicubic_cells[index];
+
+    if (cell.key != key) {
+      bicubic_cell_t fresh;
+      bicubic_make_patch(fresh, x, y);
+      fresh.key = key;
+      #if ENABLED(LEVELING_STREAM)
+        const bool was_enabled = STEPPER_ISR_ENABLED();
+        if (was_enabled) DISABLE_STEPPER_DRIVER_INTERRUPT();
+      #endif
+      cell = fresh;
+      #if ENABLED(LEVELING_STREAM)
+        if (was_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
+      #endif
+    }
 
-    if (prev.y != rel.y) {
-      prev.y = rel.y;
-      ratio.y = rel.y * ABL_BG_FACTOR(y);
-      const float gy = constrain(FLOOR(ratio.y), 0, ABL_BG_POINTS_Y - (FAR_EDGE_OR_BOX));
-      ratio.y -= gy;
+    // Now the most recently used
+    for (; o; o--) bicubic_order[o] = bicubic_order[o - 1];
+    bicubic_order[0] = index;
 
-      #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
-        // Beyond the grid maintain height at grid edges
-        NOLESS(ratio.y, 0); // Never < 0.0. (> 1.0 is ok when nextg.y==thisg.y.)
-      #endif
+    return cell;
+  }
 
-      thisg.y = gy;
-      nextg.y = _MIN(thisg.y + 1, ABL_BG_POINTS_Y - 1);
-    }
+#else
 
-    if (lastg != thisg) {
-      lastg = thisg;
-      // Z at the box corners
-      z1 = ABL_BG_GRID(thisg.x, thisg.y);       // left-front
-      d2 = ABL_BG_GRID(thisg.x, nextg.y) - z1;  // left-back (delta)
-      z3 = ABL_BG_GRID(nextg.x, thisg.y);       // right-front
-      d4 = ABL_BG_GRID(nextg.x, nextg.y) - z3;  // right-back (delta)
-    }
+  /**
+   * Bilinear coefficients for each grid cell, so that within the cell
+   * Z = z + rx * (dx + ry * dxy) + ry * dy, with rx / ry the position
+   * within the cell as a ratio of the grid spacing.
+   */
+  typedef struct { float z, dx, dy, dxy; } bilinear_cell_t;
+  static bilinear_cell_t bilinear_cells[ABL_BG_CELLS_X][ABL_BG_CELLS_Y];
 
-    // Bilinear interpolate. Needed since rel.y or thisg.x has changed.
-                L = z1 + d2 * ratio.y;   // Linear interp. LF -> LB
-    const float R = z3 + d4 * ratio.y;   // Linear interp. RF -> RB
+#endif
 
-    D = R - L;
-  }
+// Refresh after other values have been updated
+void refresh_bed_level() {
+  bilinear_grid_factor = bilinear_grid_spacing.reciprocal();
+  #if ENABLED(ABL_BILINEAR_SUBDIVISION)
+    bed_level_virt_interpolate();
+  #endif
+  #if ENABLED(ABL_BICUBIC)
+    // Drop the cached patches
+    LOOP_L_N(i, ABL_BICUBIC_CACHE) {
+      bicubic_cells[i].key = -1;
+      bicubic_order[i] = i;
+    }
+    #if ENABLED(LEVELING_STREAM)
+      bicubic_isr_cell.key = -1;
+    #endif
+  #else
+    for (uint8_t x = 0; x < ABL_BG_CELLS_X; x++)
+      for (uint8_t y = 0; y < ABL_BG_CELLS_Y; y++) {
+        const float z1 = ABL_BG_GRID(x,     y    ),   // left-front
+                    z2 = ABL_BG_GRID(x,     y + 1),   // left-back
+                    z3 = ABL_BG_GRID(x + 1, y    ),   // right-front
+                    z4 = ABL_BG_GRID(x + 1, y + 1);   // right-back
+        bilinear_cell_t &cell = bilinear_cells[x][y];
+        cell.z = z1;
+        cell.dx = z3 - z1;
+        cell.dy = z2 - z1;
+        cell.dxy = z4 - z3 - z2 + z1;
+      }
+  #endif
+}
 
-  const float offset = L + ratio.x * D;   // the offset almost always changes
+// Get the Z adjustment for non-linear bed leveling
+float bilinear_z_offset(const xy_pos_t &raw, const bool from_isr/*=false*/) {
 
-  /*
-  static float last_offset = 0;
-  if (ABS(last_offset - offset) > 0.2) {
-    SERIAL_ECHOLNPAIR("Sudden Shift at x=", rel.x, " / ", bilinear_grid_spacing.x, " -> thisg.x=", thisg.x);
-    SERIAL_ECHOLNPAIR(" y=", rel.y, " / ", bilinear_grid_spacing.y, " -> thisg.y=", thisg.y);
-    SERIAL_ECHOLNPAIR(" ratio.x=", ratio.x, " ratio.y=", ratio.y);
-    SERIAL_ECHOLNPAIR(" z1=", z1, " z2=", z2, " z3=", z3, " z4=", z4);
-    SERIAL_ECHOLNPAIR(" L=", L, " R=", R, " offset=", offset);
-  }
-  last_offset = offset;
-  //*/
+  // XY relative to the probed area, in grid units
+  const xy_pos_t rel = raw - bilinear_start.asFloat();
+  xy_float_t ratio = { rel.x * ABL_BG_FACTOR(x), rel.y * ABL_BG_FACTOR(y) };
 
-  return offset;
+  // The grid box holding the point. Constrained within bounds.
+  xy_int_t cell;
+  #if ENABLED(EXTRAPOLATE_BEYOND_GRID)
+    // Keep using the last grid box
+    cell.set(constrain(FLOOR(ratio.x), 0, ABL_BG_CELLS_X - 1),
+             constrain(FLOOR(ratio.y), 0, ABL_BG_CELLS_Y - 1));
+  #else
+    // Beyond the grid maintain height at grid edges
+    LIMIT(ratio.x, 0, ABL_BG_CELLS_X);
+    LIMIT(ratio.y, 0, ABL_BG_CELLS_Y);
+    cell.set(_MIN(int(ratio.x), ABL_BG_CELLS_X - 1),
+             _MIN(int(ratio.y), ABL_BG_CELLS_Y - 1));
+  #endif
+  ratio.x -= cell.x;
+  ratio.y -= cell.y;
+
+  #if ENABLED(ABL_BICUBIC)
+    const bicubic_cell_t &c = bicubic_patch(cell.x, cell.y, from_isr);
+    float z = 0;
+    for (uint8_t i = 4; i--;)
+      z = z * ratio.x + ((c.a[i][3] * ratio.y + c.a[i][2]) * ratio.y + c.a[i][1]) * ratio.y + c.a[i][0];
+    return z;
+  #else
+    UNUSED(from_isr);
+    const bilinear_cell_t &c = bilinear_cells[cell.x][cell.y];
+    return c.z + ratio.x * (c.dx + ratio.y * c.dxy) + ratio.y * c.dy;
+  #endif
 }
 
-#if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
+#if IS_CARTESIAN && NONE(SEGMENT_LEVELED_MOVES, LEVELING_STREAM)
 
   #define CELL_INDEX(A,V) ((V - bilinear_start.A) * ABL_BG_FACTOR(A))
 
   /**
    * Prepare a bilinear-leveled linear move on Cartesian,
    * splitting the move where it crosses grid borders.
+   *
+   * The grid lines are walked in the order the move crosses
+   * them, so each segment ends on the nearest remaining line.
    */
-  void bilinear_line_to_destination(const feedRate_t scaled_fr_mm_s, uint16_t x_splits, uint16_t y_splits) {
+  void bilinear_line_to_destination(const feedRate_t &scaled_fr_mm_s) {
     // Get current and destination cells for this line
     xy_int_t c1 { CELL_INDEX(x, current_position.x), CELL_INDEX(y, current_position.y) },
              c2 { CELL_INDEX(x, destination.x), CELL_INDEX(y, destination.y) };
-    LIMIT(c1.x, 0, ABL_BG_POINTS_X - 2);
-    LIMIT(c1.y, 0, ABL_BG_POINTS_Y - 2);
-    LIMIT(c2.x, 0, ABL_BG_POINTS_X - 2);
-    LIMIT(c2.y, 0, ABL_BG_POINTS_Y - 2);
+    LIMIT(c1.x, 0, ABL_BG_CELLS_X - 1);
+    LIMIT(c1.y, 0, ABL_BG_CELLS_Y - 1);
+    LIMIT(c2.x, 0, ABL_BG_CELLS_X - 1);
+    LIMIT(c2.y, 0, ABL_BG_CELLS_Y - 1);
 
     // Start and end in the same cell? No split needed.
-    if (c1 == c2) {
-      current_position = destination;
-      line_to_current_position(scaled_fr_mm_s);
-      return;
-    }
-
-    #define LINE_SEGMENT_END(A) (current_position.A + (destination.A - current_position.A) * normalized_dist)
-
-    float normalized_dist;
-    xyze_pos_t end;
-    const xy_int8_t gc { _MAX(c1.x, c2.x), _MAX(c1.y, c2.y) };
-
-    // Crosses on the X and not already split on this X?
-    // The x_splits flags are insurance against rounding errors.
-    if (c2.x != c1.x && TEST(x_splits, gc.x)) {
-      // Split on the X grid line
-      CBI(x_splits, gc.x);
-      end = destination;
-      destination.x = bilinear_start.x + ABL_BG_SPACING(x) * gc.x;
-      normalized_dist = (destination.x - current_position.x) / (end.x - current_position.x);
-      destination.y = LINE_SEGMENT_END(y);
-    }
-    // Crosses on the Y and not already split on this Y?
-    else if (c2.y != c1.y && TEST(y_splits, gc.y)) {
-      // Split on the Y grid line
-      CBI(y_splits, gc.y);
-      end = destination;
-      destination.y = bilinear_start.y + ABL_BG_SPACING(y) * gc.y;
-      normalized_dist = (destination.y - current_position.y) / (end.y - current_position.y);
-      destination.x = LINE_SEGMENT_END(x);
-    }
-    else {
-      // Must already have been split on these border(s)
-      // This should be a rare case.
-      current_position = destination;
-      line_to_current_position(scaled_fr_mm_s);
-      return;
+    if (c1 != c2) {
+      const xyze_pos_t start = current_position;
+      const xyze_float_t dist = destination - start;
+
+      // Grid lines to cross on each axis, the next one, and the step to the one after
+      xy_int_t count, gline, gstep;
+      count.set(ABS(c2.x - c1.x), ABS(c2.y - c1.y));
+      gline.set(c1.x + (c2.x > c1.x), c1.y + (c2.y > c1.y));
+      gstep.set(c2.x > c1.x ? 1 : -1, c2.y > c1.y ? 1 : -1);
+
+      // Portion of the move at which the next line on each axis is crossed
+      #define LINE_CROSSING(A) (count.A ? (bilinear_start.A + ABL_BG_SPACING(A) * gline.A - start.A) / dist.A : 2.0f)
+      xy_float_t t { LINE_CROSSING(x), LINE_CROSSING(y) };
+
+      while (count.x || count.y) {
+        // Split at the nearest line. Both lines at a grid corner.
+        const float tn = _MIN(t.x, t.y);
+        if (t.x == tn) { count.x--; gline.x += gstep.x; t.x = LINE_CROSSING(x); }
+        if (t.y == tn) { count.y--; gline.y += gstep.y; t.y = LINE_CROSSING(y); }
+        current_position = start + dist * constrain(tn, 0, 1);
+        line_to_current_position(scaled_fr_mm_s);
+      }
     }
 
-    destination.z = LINE_SEGMENT_END(z);
-    destination.e = LINE_SEGMENT_END(e);
-
-    // Do the split and look for more borders
-    bilinear_line_to_destination(scaled_fr_mm_s, x_splits, y_splits);
-
-    // Restore destination from stack
-    destination = end;
-    bilinear_line_to_destination(scaled_fr_mm_s, x_splits, y_splits);
+    current_position = destination;
+    line_to_current_position(scaled_fr_mm_s);
   }
 
-#endif // IS_CARTESIAN && !SEGMENT_LEVELED_MOVES
+#endif // IS_CARTESIAN && !SEGMENT_LEVELED_MOVES && !LEVELING_STREAM
 
 #endif // AUTO_BED_LEVELING_BILINEAR
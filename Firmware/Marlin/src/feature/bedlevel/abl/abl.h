@@ -26,7 +26,7 @@
 extern xy_pos_t bilinear_grid_spacing, bilinear_start;
 extern xy_float_t bilinear_grid_factor;
 extern bed_mesh_t z_values;
-float bilinear_z_offset(const xy_pos_t &raw);
+float bilinear_z_offset(const xy_pos_t &raw, const bool from_isr=false);
 
 void extrapolate_unprobed_bed_level();
 void print_bilinear_leveling_grid();
@@ -36,8 +36,8 @@ void refresh_bed_level();
   void bed_level_virt_interpolate();
 #endif
 
-#if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
-  void bilinear_line_to_destination(const feedRate_t &scaled_fr_mm_s, uint16_t x_splits=0xFFFF, uint16_t y_splits=0xFFFF);
+#if IS_CARTESIAN && NONE(SEGMENT_LEVELED_MOVES, LEVELING_STREAM)
+  void bilinear_line_to_destination(const feedRate_t &scaled_fr_mm_s);
 #endif
 
 #define _GET_MESH_X(I) float(bilinear_start.x + (I) * bilinear_grid_spacing.x)
@@ -0,0 +1,102 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(BUFFER_MONITORING)
+
+#include "buffer_monitor.h"
+#include "../module/planner.h"
+#include "../gcode/queue.h"
+#include "../MarlinCore.h"
+
+BufferMonitor buffer_monitor;
+
+volatile millis_t BufferMonitor::dry_ms; // = 0
+bool BufferMonitor::drained = true;
+uint16_t BufferMonitor::underruns;
+millis_t BufferMonitor::stall_max_ms, BufferMonitor::stall_total_ms;
+uint8_t BufferMonitor::auto_report_interval;
+millis_t BufferMonitor::next_report_ms;
+
+void BufferMonitor::reset() {
+  underruns = 0;
+  stall_max_ms = stall_total_ms = 0;
+}
+
+/**
+ * Time (ms) until the planner runs dry, from the nominal time of the moves
+ * waiting behind the active one. Ramps make them slower, so it's a low guess.
+ */
+uint16_t BufferMonitor::starvation_ms() { return planner.block_buffer_runtime(); }
+
+// Moving, but with fewer than BUFFER_LOW_TIME of moves to follow
+bool BufferMonitor::starving() {
+  return planner.has_blocks_queued() && starvation_ms() < (BUFFER_LOW_TIME);
+}
+
+void BufferMonitor::block_queued() {
+  const millis_t dry = dry_ms;
+  if (!dry) return;
+  if (!drained) {
+    const millis_t stall = millis() - dry;
+    underruns++;
+    NOLESS(stall_max_ms, stall);
+    stall_total_ms += stall;
+  }
+  dry_ms = 0;
+  drained = false;
+}
+
+void BufferMonitor::idle() {
+  // Running dry with no print going on is just the end of the moves
+  if (dry_ms && !drained && !printingIsActive()) drained = true;
+}
+
+/**
+ * Report the planner buffer:
+ *
+ *   T  Time (ms) until the planner runs dry
+ *   P  Free planner blocks
+ *   B  Free command buffer slots
+ *   U  Underruns: the planner ran dry during a print
+ *   D  Longest and total time (ms) spent waiting for moves
+ */
+void BufferMonitor::report() {
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Buffer T:", starvation_ms());
+  SERIAL_ECHOPAIR(" P:", int(planner.moves_free()));
+  SERIAL_ECHOPAIR(" B:", int(queue.free_slots()));
+  SERIAL_ECHOPAIR(" U:", underruns);
+  SERIAL_ECHOPAIR(" D:", stall_max_ms);
+  SERIAL_ECHOLNPAIR("/", stall_total_ms);
+}
+
+void BufferMonitor::auto_report() {
+  if (auto_report_interval && ELAPSED(millis(), next_report_ms)) {
+    next_report_ms = millis() + 1000UL * auto_report_interval;
+    PORT_REDIRECT(SERIAL_BOTH);
+    report();
+  }
+}
+
+#endif // BUFFER_MONITORING
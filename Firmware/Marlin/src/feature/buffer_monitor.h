@@ -0,0 +1,68 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * buffer_monitor.h - Planner buffer starvation monitor
+ *
+ * Estimates the time until the planner runs dry and counts the underruns
+ * where it ran dry in the middle of a print.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+class BufferMonitor {
+public:
+  static volatile millis_t dry_ms;      // When the Stepper found the planner empty, 0 if it hasn't
+  static bool drained;                  // The planner was emptied on purpose, so it's no underrun
+  static uint16_t underruns;            // Times the planner ran dry during a print
+  static millis_t stall_max_ms,         // Longest and total waits for the next move
+                  stall_total_ms;
+
+  static uint8_t auto_report_interval;
+  static millis_t next_report_ms;
+
+  static void reset();
+  static void report();
+  static void auto_report();
+  static void idle();
+
+  static uint16_t starvation_ms();
+  static bool starving();
+
+  // A new block is in the planner. End the stall, if any.
+  static void block_queued();
+
+  static inline void set_auto_report_interval(uint8_t v) {
+    NOMORE(v, 60);
+    auto_report_interval = v;
+    next_report_ms = millis() + 1000UL * v;
+  }
+
+  // The planner had no block to give. Called from the Stepper ISR.
+  static inline void ran_dry() { if (!dry_ms) dry_ms = millis() | 1; }
+
+  // In a requested wait, like M109 or M190. Running dry now is no underrun.
+  static inline void waiting() { if (dry_ms) drained = true; }
+};
+
+extern BufferMonitor buffer_monitor;
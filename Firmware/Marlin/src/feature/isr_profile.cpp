@@ -0,0 +1,140 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(STEPPER_ISR_PROFILE)
+
+#include "isr_profile.h"
+
+ISRProfile isr_profile;
+
+isr_phase_profile_t ISRProfile::phase[ISR_PHASE_COUNT];
+uint32_t ISRProfile::catch_ups, ISRProfile::saturations;
+millis_t ISRProfile::reset_ms;
+uint8_t ISRProfile::auto_report_interval;
+millis_t ISRProfile::next_report_ms;
+
+static const char str_pulse[] PROGMEM = "Pulse",
+                  #if ENABLED(LIN_ADVANCE)
+                    str_advance[] PROGMEM = "Advance",
+                  #endif
+                  #if ENABLED(INPUT_SHAPING)
+                    str_shaping[] PROGMEM = "Shaping",
+                  #endif
+                  #if ENABLED(LEVELING_STREAM)
+                    str_leveling[] PROGMEM = "Leveling",
+                  #endif
+                  str_block[] PROGMEM = "Block",
+                  str_total[] PROGMEM = "Total";
+
+static PGM_P const phase_name[ISR_PHASE_COUNT] PROGMEM = {
+  str_pulse,
+  #if ENABLED(LIN_ADVANCE)
+    str_advance,
+  #endif
+  #if ENABLED(INPUT_SHAPING)
+    str_shaping,
+  #endif
+  #if ENABLED(LEVELING_STREAM)
+    str_leveling,
+  #endif
+  str_block,
+  str_total
+};
+
+void ISRProfile::init() {
+  HAL_cycle_counter_init();
+  reset();
+}
+
+void ISRProfile::reset() {
+  const bool was_enabled = STEPPER_ISR_ENABLED();
+  if (was_enabled) DISABLE_STEPPER_DRIVER_INTERRUPT();
+
+  LOOP_L_N(p, ISR_PHASE_COUNT) {
+    phase[p] = {};
+    phase[p].min = UINT32_MAX;
+  }
+  catch_ups = saturations = 0;
+  reset_ms = millis();
+
+  if (was_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
+}
+
+/**
+ * Report the profile since the last reset:
+ *
+ *   Load       Share of the CPU taken by the Stepper ISR
+ *   Ceiling    ISR rate the CPU could sustain at the average ISR cost
+ *   Catch-up   Extra ISR loop passes run because the next event was already due
+ *   Saturated  ISRs cut short by the max_loops limit, losing step timing
+ *
+ * Then one line per phase with the calls, the min / avg / max cycles per
+ * call, and the histogram of call durations (<1µs, <2µs, <4µs ... rest).
+ */
+void ISRProfile::report() {
+  // Take a consistent copy, the ISR keeps counting
+  const bool was_enabled = STEPPER_ISR_ENABLED();
+  if (was_enabled) DISABLE_STEPPER_DRIVER_INTERRUPT();
+  const isr_phase_profile_t &t = phase[ISR_PHASE_TOTAL];
+  const uint64_t isr_cycles = t.sum;
+  const uint32_t isr_count = t.count, extra = catch_ups, cut = saturations;
+  if (was_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
+
+  const float elapsed_cycles = float(millis() - reset_ms) * (F_CPU / 1000UL);
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Stepper ISR Load:", elapsed_cycles ? isr_cycles * 100.0f / elapsed_cycles : 0.0f);
+  SERIAL_ECHOPAIR("% Ceiling:", isr_cycles ? uint32_t(uint64_t(F_CPU) * isr_count / isr_cycles) : 0UL);
+  SERIAL_ECHOPAIR("Hz Catch-up:", extra);
+  SERIAL_ECHOLNPAIR(" Saturated:", cut);
+
+  LOOP_L_N(p, ISR_PHASE_COUNT) {
+    if (was_enabled) DISABLE_STEPPER_DRIVER_INTERRUPT();
+    const isr_phase_profile_t s = phase[p];
+    if (was_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
+
+    SERIAL_ECHO_START();
+    SERIAL_CHAR(' ');
+    serialprintPGM((PGM_P)pgm_read_ptr(&phase_name[p]));
+    SERIAL_ECHOPAIR(" N:", s.count);
+    SERIAL_ECHOPAIR(" Min:", s.count ? s.min : 0UL);
+    SERIAL_ECHOPAIR(" Avg:", s.count ? uint32_t(s.sum / s.count) : 0UL);
+    SERIAL_ECHOPAIR(" Max:", s.max);
+    SERIAL_ECHOPGM(" Hist:");
+    LOOP_L_N(b, STEPPER_ISR_PROFILE_BINS) {
+      if (b) SERIAL_CHAR(' ');
+      SERIAL_ECHO(s.bin[b]);
+    }
+    SERIAL_EOL();
+  }
+}
+
+void ISRProfile::auto_report() {
+  if (auto_report_interval && ELAPSED(millis(), next_report_ms)) {
+    next_report_ms = millis() + 1000UL * auto_report_interval;
+    PORT_REDIRECT(SERIAL_BOTH);
+    report();
+  }
+}
+
+#endif // STEPPER_ISR_PROFILE
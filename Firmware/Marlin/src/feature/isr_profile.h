@@ -0,0 +1,94 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * isr_profile.h - Stepper ISR load profiler
+ *
+ * Times each phase of Stepper::isr() with the HAL cycle counter.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+enum ISRPhase : uint8_t {
+  ISR_PHASE_PULSE,                      // stepper_pulse_phase_isr()
+  #if ENABLED(LIN_ADVANCE)
+    ISR_PHASE_ADVANCE,                  // advance_isr()
+  #endif
+  #if ENABLED(INPUT_SHAPING)
+    ISR_PHASE_SHAPING,                  // shaping_isr()
+  #endif
+  #if ENABLED(LEVELING_STREAM)
+    ISR_PHASE_LEVELING,                 // leveling_isr()
+  #endif
+  ISR_PHASE_BLOCK,                      // stepper_block_phase_isr()
+  ISR_PHASE_TOTAL,                      // The whole ISR, catch-up passes included
+  ISR_PHASE_COUNT
+};
+
+typedef struct {
+  uint32_t count, min, max;             // Calls, and fewest / most cycles per call
+  uint64_t sum;                         // Total cycles
+  uint32_t bin[STEPPER_ISR_PROFILE_BINS]; // Calls taking <1µs, <2µs, <4µs ... and the rest
+} isr_phase_profile_t;
+
+class ISRProfile {
+public:
+  static isr_phase_profile_t phase[ISR_PHASE_COUNT];
+  static uint32_t catch_ups,            // Extra ISR loop passes for events already due (min_ticks)
+                  saturations;          // ISRs cut short by the max_loops limit
+  static millis_t reset_ms;
+
+  static uint8_t auto_report_interval;
+  static millis_t next_report_ms;
+
+  static void init();
+  static void reset();
+  static void report();
+  static void auto_report();
+
+  static inline void set_auto_report_interval(uint8_t v) {
+    NOMORE(v, 60);
+    auto_report_interval = v;
+    next_report_ms = millis() + 1000UL * v;
+  }
+
+  // Add a sample. Called from the Stepper ISR.
+  static inline void record(const ISRPhase p, const uint32_t cycles) {
+    isr_phase_profile_t &s = phase[p];
+    s.count++;
+    s.sum += cycles;
+    NOMORE(s.min, cycles);
+    NOLESS(s.max, cycles);
+    const uint32_t us = cycles / (F_CPU / 1000000UL);
+    s.bin[us ? _MIN(STEPPER_ISR_PROFILE_BINS - 1, 32 - __builtin_clz(us)) : 0]++;
+  }
+};
+
+extern ISRProfile isr_profile;
+
+// Time one statement of the Stepper ISR
+#define ISR_PROFILE_PHASE(P, CODE) do{ \
+  const uint32_t _phase_start = HAL_cycle_count(); \
+  CODE; \
+  isr_profile.record(P, HAL_cycle_count() - _phase_start); \
+}while(0)
@@ -69,8 +69,8 @@ static_assert(NR_MIXING_VIRTUAL_TOOLS <= MAX_VTOOLS, "MIXING_VIRTUAL_TOOLS must
   for (uint_fast8_t VAR = 0; VAR < MIXING_STEPPERS; VAR++)
 
 #define MIXER_BLOCK_FIELD       mixer_comp_t b_color[MIXING_STEPPERS]
-#define MIXER_POPULATE_BLOCK()  mixer.populate_block(block->b_color)
-#define MIXER_STEPPER_SETUP()   mixer.stepper_setup(current_block->b_color)
+#define MIXER_POPULATE_BLOCK()  mixer.populate_block(aux_data.b_color)
+#define MIXER_STEPPER_SETUP()   mixer.stepper_setup(planner.aux(current_block).b_color)
 
 #if ENABLED(GRADIENT_MIX)
 
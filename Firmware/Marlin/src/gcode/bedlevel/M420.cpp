@@ -78,6 +78,9 @@ void GcodeSuite::M420() {
             ExtUI::onMeshUpdate(x, y, Z_VALUES(x, y));
           #endif
         }
+      #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+        refresh_bed_level();
+      #endif
       SERIAL_ECHOPGM("Simulated " STRINGIFY(GRID_MAX_POINTS_X) "x" STRINGIFY(GRID_MAX_POINTS_Y) " mesh ");
       SERIAL_ECHOPAIR(" (", x_min);
       SERIAL_CHAR(','); SERIAL_ECHO(y_min);
@@ -187,8 +190,8 @@ void GcodeSuite::M420() {
                   ExtUI::onMeshUpdate(x, y, Z_VALUES(x, y));
                 #endif
               }
-            #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-              bed_level_virt_interpolate();
+            #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+              refresh_bed_level();
             #endif
           }
 
@@ -45,7 +45,7 @@
   #include "../../../lcd/ultralcd.h"
 #endif
 
-#if ENABLED(AUTO_BED_LEVELING_LINEAR)
+#if EITHER(AUTO_BED_LEVELING_LINEAR, ABL_ADAPTIVE_PROBING)
   #include "../../../libs/least_squares_fit.h"
 #endif
 
@@ -60,6 +60,10 @@
   #include "../../../lcd/extensible_ui/ui_api.h"
 #endif
 
+#if BOTH(G29_PRINT_AREA, SDSUPPORT)
+  #include "../../../sd/cardreader.h"
+#endif
+
 #if HOTENDS > 1
   #include "../../../module/tool_change.h"
 #endif
@@ -78,6 +82,45 @@
   #endif
 #endif
 
+#if ENABLED(ABL_ADAPTIVE_PROBING)
+
+  // Grid points measured by the current G29, and those the current pass still wants
+  static bool adaptive_probed[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y],
+              adaptive_wanted[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+
+  // Grid lines at stride s are the multiples of s, plus the last line
+  FORCE_INLINE bool adaptive_on_stride(const uint8_t i, const uint8_t s, const uint8_t n) {
+    return i % s == 0 || i == n - 1;
+  }
+  FORCE_INLINE uint8_t adaptive_next(const uint8_t i, const uint8_t s, const uint8_t n) {
+    return _MIN((i / s + 1) * s, n - 1);
+  }
+
+  /**
+   * Fit a plane to the stride-s points of a cell and its neighbors and
+   * return the largest residual. Flat or evenly tilted areas fit exactly,
+   * while a bow, twist, or bump shows up as a residual.
+   */
+  static float adaptive_cell_residual(const xy_uint8_t &lo, const xy_uint8_t &hi, const uint8_t s) {
+    auto in_window = [&](const uint8_t x, const uint8_t y) {
+      return x + s >= lo.x && x <= hi.x + s && y + s >= lo.y && y <= hi.y + s
+          && adaptive_on_stride(x, s, GRID_MAX_POINTS_X) && adaptive_on_stride(y, s, GRID_MAX_POINTS_Y);
+    };
+
+    linear_fit_data lsf;
+    incremental_LSF_reset(&lsf);
+    LOOP_L_N(x, GRID_MAX_POINTS_X) LOOP_L_N(y, GRID_MAX_POINTS_Y)
+      if (in_window(x, y)) incremental_LSF(&lsf, x, y, z_values[x][y]);
+    if (finish_incremental_LSF(&lsf)) return INFINITY;
+
+    float residual = 0;
+    LOOP_L_N(x, GRID_MAX_POINTS_X) LOOP_L_N(y, GRID_MAX_POINTS_Y)
+      if (in_window(x, y)) NOLESS(residual, ABS(z_values[x][y] + lsf.A * x + lsf.B * y + lsf.D));
+    return residual;
+  }
+
+#endif
+
 #if ENABLED(G29_RETRY_AND_RECOVER)
   #define G29_RETURN(b) return b;
 #else
@@ -137,6 +180,19 @@
  *
  *  Z  Supply an additional Z probe offset
  *
+ * Parameters with G29_PRINT_AREA only:
+ *
+ *  U  Probe only the grid points around the print area, plus PRINT_AREA_MARGIN,
+ *     and keep the rest of the stored mesh. L R F B give the print area. Without
+ *     them it comes from the header of the SD file being printed. With no stored
+ *     mesh the print area is probed as a new grid, and if the stored grid doesn't
+ *     cover the print area, a new grid over both is probed.
+ *
+ * Parameters with ABL_ADAPTIVE_PROBING only:
+ *
+ *  K  Plane-fit residual (mm) above which a coarse cell gets probed more densely.
+ *     With K0 every grid point is probed.
+ *
  * Extra parameters with PROBE_MANUALLY:
  *
  *  To do manual probing simply repeat G29 until the procedure is complete.
@@ -253,6 +309,11 @@ G29_TYPE GcodeSuite::G29() {
 
       ABL_VAR float zoffset;
 
+      #if ENABLED(G29_PRINT_AREA)
+        ABL_VAR bool print_area;
+        ABL_VAR xy_int8_t area_lo, area_hi; // Grid points spanning the print area
+      #endif
+
     #elif ENABLED(AUTO_BED_LEVELING_LINEAR)
 
       ABL_VAR int indexIntoAB[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
@@ -322,9 +383,7 @@ G29_TYPE GcodeSuite::G29() {
         if (WITHIN(i, 0, GRID_MAX_POINTS_X - 1) && WITHIN(j, 0, GRID_MAX_POINTS_Y)) {
           set_bed_leveling_enabled(false);
           z_values[i][j] = rz;
-          #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-            bed_level_virt_interpolate();
-          #endif
+          refresh_bed_level();
           #if ENABLED(EXTENSIBLE_UI)
             ExtUI::onMeshUpdate(i, j, rz);
           #endif
@@ -395,6 +454,58 @@ G29_TYPE GcodeSuite::G29() {
       const float x_min = probe_min_x(), x_max = probe_max_x(),
                   y_min = probe_min_y(), y_max = probe_max_y();
 
+      #if ENABLED(G29_PRINT_AREA)
+        xy_pos_t area_min = { 0, 0 }, area_max = { 0, 0 };
+        print_area = parser.seen('U');
+        if (print_area) {
+          if (parser.seenval('L') && parser.seenval('R') && parser.seenval('F') && parser.seenval('B')) {
+            area_min.set(parser.linearval('L'), parser.linearval('F'));
+            area_max.set(parser.linearval('R'), parser.linearval('B'));
+          }
+          #if ENABLED(SDSUPPORT)
+            else if (card.isFileOpen() && card.flag.print_area) {
+              area_min = card.print_area_min;
+              area_max = card.print_area_max;
+            }
+          #endif
+          else {
+            SERIAL_ECHOLNPGM("?(U) needs L R F B or an SD print with its area in the header.");
+            G29_RETURN(false);
+          }
+          area_min.set(RAW_X_POSITION(area_min.x) - (PRINT_AREA_MARGIN), RAW_Y_POSITION(area_min.y) - (PRINT_AREA_MARGIN));
+          area_max.set(RAW_X_POSITION(area_max.x) + (PRINT_AREA_MARGIN), RAW_Y_POSITION(area_max.y) + (PRINT_AREA_MARGIN));
+
+          // Keep to where the probe can reach
+          area_min.set(_MAX(area_min.x, x_min), _MAX(area_min.y, y_min));
+          area_max.set(_MIN(area_max.x, x_max), _MIN(area_max.y, y_max));
+
+          // Without a stored mesh to update, make a new grid over the print area
+          if (!leveling_is_valid()) print_area = false;
+          else {
+            // If the stored grid doesn't cover the print area, make a new grid over both
+            const xy_pos_t grid_max = { _GET_MESH_X(GRID_MAX_POINTS_X - 1), _GET_MESH_Y(GRID_MAX_POINTS_Y - 1) };
+            constexpr float slop = 0.01f; // (mm) Rounding of the stored grid
+            if (area_min.x < bilinear_start.x - slop || area_min.y < bilinear_start.y - slop
+             || area_max.x > grid_max.x + slop || area_max.y > grid_max.y + slop
+            ) {
+              area_min.set(_MIN(area_min.x, bilinear_start.x), _MIN(area_min.y, bilinear_start.y));
+              area_max.set(_MAX(area_max.x, grid_max.x), _MAX(area_max.y, grid_max.y));
+              print_area = false;
+            }
+          }
+        }
+
+        if (print_area) {
+          probe_position_lf = bilinear_start;
+          probe_position_rb.set(bilinear_start.x + bilinear_grid_spacing.x * (GRID_MAX_POINTS_X - 1),
+                                bilinear_start.y + bilinear_grid_spacing.y * (GRID_MAX_POINTS_Y - 1));
+        }
+        else if (parser.seen('U')) {
+          probe_position_lf = area_min;
+          probe_position_rb = area_max;
+        }
+        else
+      #endif
       if (parser.seen('H')) {
         const int16_t size = (int16_t)parser.value_linear_units();
         probe_position_lf.set(
@@ -436,6 +547,17 @@ G29_TYPE GcodeSuite::G29() {
       gridSpacing.set((probe_position_rb.x - probe_position_lf.x) / (abl_grid_points.x - 1),
                       (probe_position_rb.y - probe_position_lf.y) / (abl_grid_points.y - 1));
 
+      #if ENABLED(G29_PRINT_AREA)
+        if (print_area) {
+          // Keep the stored grid exactly, and find the cells under the print area
+          gridSpacing = bilinear_grid_spacing;
+          area_lo.set(constrain(FLOOR((area_min.x - probe_position_lf.x) / gridSpacing.x), 0, GRID_MAX_POINTS_X - 1),
+                      constrain(FLOOR((area_min.y - probe_position_lf.y) / gridSpacing.y), 0, GRID_MAX_POINTS_Y - 1));
+          area_hi.set(constrain(CEIL((area_max.x - probe_position_lf.x) / gridSpacing.x), 0, GRID_MAX_POINTS_X - 1),
+                      constrain(CEIL((area_max.y - probe_position_lf.y) / gridSpacing.y), 0, GRID_MAX_POINTS_Y - 1));
+        }
+      #endif
+
     #endif // ABL_GRID
 
     if (verbose_level > 0) {
@@ -662,7 +784,120 @@ G29_TYPE GcodeSuite::G29() {
 
     measured_z = 0;
 
-    #if ABL_GRID
+    #if ENABLED(ABL_ADAPTIVE_PROBING)
+
+      const float threshold = parser.linearval('K', ABL_ADAPTIVE_THRESHOLD);
+      uint16_t probe_count = 0;
+      xy_int8_t meshCount;
+
+      // Probe the wanted points not yet probed, zig-zagging like the full grid
+      auto probe_wanted_points = [&]{
+        bool zig = PR_OUTER_END & 1;
+        for (PR_OUTER_VAR = 0; PR_OUTER_VAR < PR_OUTER_END; PR_OUTER_VAR++, zig ^= true) {
+          LOOP_L_N(n, PR_INNER_END) {
+            PR_INNER_VAR = zig ? n : PR_INNER_END - 1 - n;
+            if (!adaptive_wanted[meshCount.x][meshCount.y] || adaptive_probed[meshCount.x][meshCount.y]) continue;
+
+            probePos = probe_position_lf + gridSpacing * meshCount.asFloat();
+
+            ++probe_count;
+            if (verbose_level) SERIAL_ECHOLNPAIR("Probing mesh point ", int(probe_count), " (", int(meshCount.x), ",", int(meshCount.y), ").");
+            #if HAS_DISPLAY
+              ui.status_printf_P(0, PSTR(S_FMT " %i/%i"), GET_TEXT(MSG_PROBING_MESH), int(probe_count), int(GRID_MAX_POINTS));
+            #endif
+
+            measured_z = faux ? 0.001f * random(-100, 101) : probe_at_point(probePos, raise_after, verbose_level);
+
+            if (isnan(measured_z)) {
+              set_bed_leveling_enabled(abl_should_enable);
+              return false;
+            }
+
+            #if ENABLED(PROBE_TEMP_COMPENSATION)
+              temp_comp.compensate_measurement(TSI_BED, thermalManager.degBed(), measured_z);
+              temp_comp.compensate_measurement(TSI_PROBE, thermalManager.degProbe(), measured_z);
+              #if ENABLED(USE_TEMP_EXT_COMPENSATION)
+                temp_comp.compensate_measurement(TSI_EXT, thermalManager.degHotend(), measured_z);
+              #endif
+            #endif
+
+            z_values[meshCount.x][meshCount.y] = measured_z + zoffset;
+            adaptive_probed[meshCount.x][meshCount.y] = true;
+            #if ENABLED(EXTENSIBLE_UI)
+              ExtUI::onMeshUpdate(meshCount, z_values[meshCount.x][meshCount.y]);
+            #endif
+
+            abl_should_enable = false;
+            idle();
+          }
+        }
+        return true;
+      };
+
+      // Start with the coarse grid
+      uint8_t s = ABL_ADAPTIVE_STRIDE;
+      ZERO(adaptive_probed);
+      LOOP_L_N(x, GRID_MAX_POINTS_X) LOOP_L_N(y, GRID_MAX_POINTS_Y)
+        adaptive_wanted[x][y] = adaptive_on_stride(x, s, GRID_MAX_POINTS_X) && adaptive_on_stride(y, s, GRID_MAX_POINTS_Y);
+
+      #if ENABLED(G29_PRINT_AREA)
+        // Every point around the print area, in a single pass
+        if (print_area) {
+          s = 1;
+          LOOP_L_N(x, GRID_MAX_POINTS_X) LOOP_L_N(y, GRID_MAX_POINTS_Y)
+            adaptive_wanted[x][y] = WITHIN(x, area_lo.x, area_hi.x) && WITHIN(y, area_lo.y, area_hi.y);
+        }
+      #endif
+
+      // Halve the stride in the cells that don't fit a plane. Interpolate the rest.
+      for (bool ok = probe_wanted_points(); ok && s > 1; s >>= 1) {
+        const uint8_t h = s >> 1;
+        xy_uint8_t lo, hi;
+
+        // Only cells with all four corners probed can be refined further
+        ZERO(adaptive_wanted);
+        for (lo.x = 0; lo.x < GRID_MAX_POINTS_X - 1; lo.x = hi.x) {
+          hi.x = adaptive_next(lo.x, s, GRID_MAX_POINTS_X);
+          for (lo.y = 0; lo.y < GRID_MAX_POINTS_Y - 1; lo.y = hi.y) {
+            hi.y = adaptive_next(lo.y, s, GRID_MAX_POINTS_Y);
+            if (!( adaptive_probed[lo.x][lo.y] && adaptive_probed[hi.x][lo.y]
+                && adaptive_probed[lo.x][hi.y] && adaptive_probed[hi.x][hi.y])) continue;
+            if (threshold > 0 && adaptive_cell_residual(lo, hi, s) <= threshold) continue;
+            LOOP_S_LE_N(x, lo.x, hi.x) LOOP_S_LE_N(y, lo.y, hi.y)
+              if (adaptive_on_stride(x, h, GRID_MAX_POINTS_X) && adaptive_on_stride(y, h, GRID_MAX_POINTS_Y))
+                adaptive_wanted[x][y] = true;
+          }
+        }
+
+        ok = probe_wanted_points();
+        if (!ok) break;
+
+        // Fill the new stride-h points of the remaining cells from their corners
+        for (lo.x = 0; lo.x < GRID_MAX_POINTS_X - 1; lo.x = hi.x) {
+          hi.x = adaptive_next(lo.x, s, GRID_MAX_POINTS_X);
+          for (lo.y = 0; lo.y < GRID_MAX_POINTS_Y - 1; lo.y = hi.y) {
+            hi.y = adaptive_next(lo.y, s, GRID_MAX_POINTS_Y);
+            LOOP_S_LE_N(x, lo.x, hi.x) LOOP_S_LE_N(y, lo.y, hi.y) {
+              if (adaptive_probed[x][y]
+                || !adaptive_on_stride(x, h, GRID_MAX_POINTS_X) || !adaptive_on_stride(y, h, GRID_MAX_POINTS_Y)
+                || (adaptive_on_stride(x, s, GRID_MAX_POINTS_X) && adaptive_on_stride(y, s, GRID_MAX_POINTS_Y))
+              ) continue;
+              const float rx = float(x - lo.x) / (hi.x - lo.x), ry = float(y - lo.y) / (hi.y - lo.y),
+                          z0 = z_values[lo.x][lo.y] + (z_values[hi.x][lo.y] - z_values[lo.x][lo.y]) * rx,
+                          z1 = z_values[lo.x][hi.y] + (z_values[hi.x][hi.y] - z_values[lo.x][hi.y]) * rx;
+              z_values[x][y] = z0 + (z1 - z0) * ry;
+              #if ENABLED(EXTENSIBLE_UI)
+                ExtUI::onMeshUpdate(x, y, z_values[x][y]);
+              #endif
+            }
+          }
+        }
+      }
+
+      if (verbose_level && !isnan(measured_z))
+        SERIAL_ECHOLNPAIR("Adaptive probing measured ", int(probe_count), " of ", int(GRID_MAX_POINTS), " points.");
+
+    #elif ABL_GRID
 
       bool zig = PR_OUTER_END & 1;  // Always end at RIGHT and BACK_PROBE_BED_POSITION
 
@@ -702,6 +937,11 @@ G29_TYPE GcodeSuite::G29() {
             indexIntoAB[meshCount.x][meshCount.y] = ++abl_probe_index; // 0...
           #endif
 
+          #if ENABLED(G29_PRINT_AREA)
+            // Keep the stored mesh away from the print area
+            if (print_area && !(WITHIN(meshCount.x, area_lo.x, area_hi.x) && WITHIN(meshCount.y, area_lo.y, area_hi.y))) continue;
+          #endif
+
           #if IS_KINEMATIC
             // Avoid probing outside the round or hexagonal area
             if (!position_is_reachable_by_probe(probePos)) continue;
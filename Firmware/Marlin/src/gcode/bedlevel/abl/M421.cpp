@@ -55,9 +55,7 @@ void GcodeSuite::M421() {
     SERIAL_ERROR_MSG(MSG_ERR_MESH_XY);
   else {
     z_values[ix][iy] = parser.value_linear_units() + (hasQ ? z_values[ix][iy] : 0);
-    #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-      bed_level_virt_interpolate();
-    #endif
+    refresh_bed_level();
     #if ENABLED(EXTENSIBLE_UI)
       ExtUI::onMeshUpdate(ix, iy, z_values[ix][iy]);
     #endif
@@ -73,6 +73,8 @@ void GcodeSuite::M3_M4(const bool is_M4) {
 
   #if ENABLED(SPINDLE_FEATURE)
     planner.synchronize();   // Wait for movement to complete before changing power
+  #elif ENABLED(SEGMENT_COALESCING)
+    planner.flush_coalesced(); // Moves before this keep the old power
   #endif
 
   cutter.set_direction(is_M4);
@@ -93,6 +95,8 @@ void GcodeSuite::M3_M4(const bool is_M4) {
 void GcodeSuite::M5() {
   #if ENABLED(SPINDLE_FEATURE)
     planner.synchronize();
+  #elif ENABLED(SEGMENT_COALESCING)
+    planner.flush_coalesced();
   #endif
   cutter.set_enabled(false);
 }
@@ -0,0 +1,89 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(INPUT_SHAPING)
+
+#include "../../gcode.h"
+#include "../../../module/planner.h"
+#include "../../../module/stepper.h"
+
+/**
+ * M593: Get or Set Input Shaping parameters
+ *  X           Set the X axis
+ *  Y           Set the Y axis (with neither X nor Y, set both)
+ *  F<hz>       Ringing frequency, 1 or more. 0 turns shaping off.
+ *  D<zeta>     Damping ratio (0-0.99)
+ *  T<type>     Shaper type: 0=ZV 1=ZVD 2=MZV
+ *
+ * With no F, D or T report the current settings.
+ */
+void GcodeSuite::M593() {
+  const bool seen_x = parser.seen('X'), seen_y = parser.seen('Y');
+  const bool for_axis[2] = { seen_x || !seen_y, seen_y || !seen_x };
+  bool changed = false;
+
+  if (parser.seenval('F')) {
+    const float freq = parser.value_float();
+    if (freq == 0 || freq >= SHAPING_MIN_FREQ) {
+      LOOP_L_N(a, 2) if (for_axis[a]) stepper.shaper_settings[a].frequency = freq;
+      changed = true;
+    }
+    else
+      SERIAL_ECHOLNPGM("?F value out of range (0, or " STRINGIFY(SHAPING_MIN_FREQ) " or more).");
+  }
+
+  if (parser.seenval('D')) {
+    const float zeta = parser.value_float();
+    if (WITHIN(zeta, 0, 0.99f)) {
+      LOOP_L_N(a, 2) if (for_axis[a]) stepper.shaper_settings[a].zeta = zeta;
+      changed = true;
+    }
+    else
+      SERIAL_ECHOLNPGM("?D value out of range (0-0.99).");
+  }
+
+  if (parser.seenval('T')) {
+    const uint8_t type = parser.value_byte();
+    if (type <= SHAPER_MZV) {
+      LOOP_L_N(a, 2) if (for_axis[a]) stepper.shaper_settings[a].type = type;
+      changed = true;
+    }
+    else
+      SERIAL_ECHOLNPGM("?T value out of range (0-2).");
+  }
+
+  if (changed) {
+    planner.synchronize();
+    stepper.refresh_shaping();
+  }
+  else {
+    LOOP_L_N(a, 2) {
+      const shaper_settings_t &ss = stepper.shaper_settings[a];
+      SERIAL_ECHO_START();
+      SERIAL_ECHOLNPAIR("Input Shaping ", a ? 'Y' : 'X', " F", ss.frequency, " D", ss.zeta, " T", int(ss.type));
+    }
+  }
+}
+
+#endif // INPUT_SHAPING
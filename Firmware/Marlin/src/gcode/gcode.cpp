@@ -581,6 +581,14 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 211: M211(); break;                                  // M211: Enable, Disable, and/or Report software endstops
       #endif
 
+      #if ENABLED(STEPPER_ISR_PROFILE)
+        case 215: M215(); break;                                  // M215: Report Stepper ISR load
+      #endif
+
+      #if ENABLED(PLANNER_STATS)
+        case 216: M216(); break;                                  // M216: Report planner look-ahead statistics
+      #endif
+
       #if EXTRUDERS > 1
         case 217: M217(); break;                                  // M217: Set filament swap parameters
       #endif
@@ -722,6 +730,14 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 575: M575(); break;                                  // M575: Set serial baudrate
       #endif
 
+      #if ENABLED(BUFFER_MONITORING)
+        case 576: M576(); break;                                  // M576: Report planner buffer and underruns
+      #endif
+
+      #if ENABLED(INPUT_SHAPING)
+        case 593: M593(); break;                                  // M593: Set Input Shaping parameters
+      #endif
+
       #if ENABLED(ADVANCED_PAUSE_FEATURE)
         case 600: M600(); break;                                  // M600: Pause for Filament Change
         case 603: M603(); break;                                  // M603: Configure Filament Change
@@ -877,7 +893,7 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
  * This is called from the main loop()
  */
 void GcodeSuite::process_next_command() {
-  char * const current_command = queue.command_buffer[queue.index_r];
+  char * const current_command = queue.command(queue.index_r);
 
   PORT_REDIRECT(queue.port[queue.index_r]);
 
@@ -887,10 +903,17 @@ void GcodeSuite::process_next_command() {
 
   if (DEBUGGING(ECHO)) {
     SERIAL_ECHO_START();
+    #if HAS_BINARY_COMMANDS
+      if (current_command[0] == BINARY_GCODE_MARK) {
+        SERIAL_CHAR(current_command[2] & 0x7F);
+        SERIAL_ECHOLN((uint8_t)current_command[3] | ((uint8_t)current_command[4] << 8));
+      }
+      else
+    #endif
     SERIAL_ECHOLN(current_command);
     #if ENABLED(M100_FREE_MEMORY_DUMPER)
       SERIAL_ECHOPAIR("slot:", queue.index_r);
-      M100_dump_routine(PSTR("   Command Queue:"), &queue.command_buffer[0][0], &queue.command_buffer[BUFSIZE - 1][MAX_CMD_SIZE - 1]);
+      M100_dump_routine(PSTR("   Command Queue:"), (char*)queue.command_buffer, (char*)queue.command_buffer + sizeof(queue.command_buffer) - 1);
     #endif
   }
 
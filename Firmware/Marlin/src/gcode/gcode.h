@@ -177,6 +177,8 @@
  * M209 - Turn Automatic Retract Detection on/off: S<0|1> (For slicers that don't support G10/11). (Requires FWRETRACT_AUTORETRACT)
           Every normal extrude-only move will be classified as retract depending on the direction.
  * M211 - Enable, Disable, and/or Report software endstops: S<0|1> (Requires MIN_SOFTWARE_ENDSTOPS or MAX_SOFTWARE_ENDSTOPS)
+ * M215 - Report Stepper ISR load: "M215 S<seconds> R". S sets the auto-report interval, R resets. (Requires STEPPER_ISR_PROFILE)
+ * M216 - Report planner look-ahead statistics. R to reset. (Requires PLANNER_STATS)
  * M217 - Set filament swap parameters: "M217 S<length> P<feedrate> R<feedrate>". (Requires SINGLENOZZLE)
  * M218 - Set/get a tool offset: "M218 T<index> X<offset> Y<offset>". (Requires 2 or more extruders)
  * M220 - Set Feedrate Percentage: "M220 S<percent>" (i.e., "FR" on the LCD)
@@ -226,6 +228,8 @@
  * M524 - Abort the current SD print job started with M24. (Requires SDSUPPORT)
  * M540 - Enable/disable SD card abort on endstop hit: "M540 S<state>". (Requires SD_ABORT_ON_ENDSTOP_HIT)
  * M569 - Enable stealthChop on an axis. (Requires at least one _DRIVER_TYPE to be TMC2130/2160/2208/2209/5130/5160)
+ * M576 - Report planner buffer time and underruns: "M576 S<seconds> R". S sets the auto-report interval, R resets. (Requires BUFFER_MONITORING)
+ * M593 - Set or get Input Shaping: "M593 X Y F<hz> D<zeta> T<type>". F0 turns shaping off. (Requires INPUT_SHAPING)
  * M600 - Pause for filament change: "M600 X<pos> Y<pos> Z<raise> E<first_retract> L<later_retract>". (Requires ADVANCED_PAUSE_FEATURE)
  * M603 - Configure filament change: "M603 T<tool> U<unload_length> L<load_length>". (Requires ADVANCED_PAUSE_FEATURE)
  * M605 - Set Dual X-Carriage movement mode: "M605 S<mode> [X<x_offset>] [R<temp_offset>]". (Requires DUAL_X_CARRIAGE)
@@ -694,6 +698,14 @@ private:
 
   static void M211();
 
+  #if ENABLED(STEPPER_ISR_PROFILE)
+    static void M215();
+  #endif
+
+  #if ENABLED(PLANNER_STATS)
+    static void M216();
+  #endif
+
   #if EXTRUDERS > 1
     static void M217();
   #endif
@@ -841,6 +853,14 @@ private:
     static void M575();
   #endif
 
+  #if ENABLED(BUFFER_MONITORING)
+    static void M576();
+  #endif
+
+  #if ENABLED(INPUT_SHAPING)
+    static void M593();
+  #endif
+
   #if ENABLED(ADVANCED_PAUSE_FEATURE)
     static void M600();
     static void M603();
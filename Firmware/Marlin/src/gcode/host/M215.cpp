@@ -0,0 +1,45 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(STEPPER_ISR_PROFILE)
+
+#include "../gcode.h"
+#include "../../feature/isr_profile.h"
+
+/**
+ * M215: Report the Stepper ISR load profile
+ *
+ *   S<seconds>  Set the auto-report interval (0 to stop). No report is printed.
+ *   R           Reset the profile after reporting
+ */
+void GcodeSuite::M215() {
+  if (parser.seenval('S'))
+    isr_profile.set_auto_report_interval(parser.value_byte());
+  else
+    isr_profile.report();
+
+  if (parser.seen('R')) isr_profile.reset();
+}
+
+#endif // STEPPER_ISR_PROFILE
@@ -0,0 +1,50 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_STATS)
+
+#include "../gcode.h"
+#include "../../module/planner.h"
+
+/**
+ * M216: Report planner look-ahead statistics
+ *
+ *   Recalcs: calls to Planner::recalculate() since the last reset
+ *   Reverse, Forward, Trapezoid: blocks revisited by each pass, total and single-pass maximum
+ *   Trapezoids: trapezoids recalculated
+ *
+ *   R  Reset the counters after reporting
+ */
+void GcodeSuite::M216() {
+  const planner_stats_t &s = planner.stats;
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Recalcs:", s.recalcs);
+  SERIAL_ECHOPAIR(" Reverse:", s.reverse_visits, "/", s.reverse_max);
+  SERIAL_ECHOPAIR(" Forward:", s.forward_visits, "/", s.forward_max);
+  SERIAL_ECHOPAIR(" Trapezoid:", s.trapezoid_visits, "/", s.trapezoid_max);
+  SERIAL_ECHOLNPAIR(" Trapezoids:", s.trapezoids);
+  if (parser.seen('R')) planner.reset_stats();
+}
+
+#endif // PLANNER_STATS
@@ -0,0 +1,45 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(BUFFER_MONITORING)
+
+#include "../gcode.h"
+#include "../../feature/buffer_monitor.h"
+
+/**
+ * M576: Report the planner buffer and its underruns
+ *
+ *   S<seconds>  Set the auto-report interval (0 to stop). No report is printed.
+ *   R           Reset the underrun counts after reporting
+ */
+void GcodeSuite::M576() {
+  if (parser.seenval('S'))
+    buffer_monitor.set_auto_report_interval(parser.value_byte());
+  else
+    buffer_monitor.report();
+
+  if (parser.seen('R')) buffer_monitor.reset();
+}
+
+#endif // BUFFER_MONITORING
@@ -45,6 +45,7 @@
  *
  * The arc is approximated by generating many small linear segments.
  * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
+ * or chosen by the radius for a maximum chord error of ARC_CHORD_TOLERANCE.
  * Arcs should only be made relatively large (over 5mm), as larger arcs with
  * larger segments will tend to be more efficient. Your slicer should have
  * options for G2/G3 arc generation. In future these options may be GCode tunable.
@@ -105,7 +106,14 @@ void plan_arc(
 
   const feedRate_t scaled_fr_mm_s = MMS_SCALED(feedrate_mm_s);
 
-  #ifdef ARC_SEGMENTS_PER_R
+  #ifdef ARC_CHORD_TOLERANCE
+    // A chord of length c deviates c^2/8r from the arc at its middle
+    float seg_length = SQRT(8 * radius * (ARC_CHORD_TOLERANCE));
+    #if ARC_SEGMENTS_PER_SEC
+      NOLESS(seg_length, scaled_fr_mm_s * RECIPROCAL(ARC_SEGMENTS_PER_SEC));
+    #endif
+    NOLESS(seg_length, MM_PER_ARC_SEGMENT);
+  #elif defined(ARC_SEGMENTS_PER_R)
     float seg_length = MM_PER_ARC_SEGMENT * radius;
     LIMIT(seg_length, MM_PER_ARC_SEGMENT, ARC_SEGMENTS_PER_R);
   #elif ARC_SEGMENTS_PER_SEC
@@ -222,6 +230,11 @@ void plan_arc(
       #endif
     ))
       break;
+
+    #if ENABLED(ARC_JUNCTION_SPEED)
+      // The next junctions are within the arc
+      planner.arc_radius = radius;
+    #endif
   }
 
   // Ensure last segment arrives at target location.
@@ -242,6 +255,10 @@ void plan_arc(
     #endif
   );
 
+  #if ENABLED(ARC_JUNCTION_SPEED)
+    planner.arc_radius = 0;
+  #endif
+
   #if ENABLED(AUTO_BED_LEVELING_UBL)
     raw[l_axis] = start_L;
   #endif
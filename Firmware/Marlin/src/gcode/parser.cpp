@@ -70,6 +70,11 @@ int GCodeParser::codenum;
   char *GCodeParser::command_args; // start of parameters
 #endif
 
+#if HAS_BINARY_COMMANDS
+  bool GCodeParser::binary;
+  float GCodeParser::binval[26];   // binary parameter values
+#endif
+
 // Create a global instance of the GCode parser singleton
 GCodeParser parser;
 
@@ -90,6 +95,9 @@ void GCodeParser::reset() {
     codebits = 0;                       // No codes yet
     //ZERO(param);                      // No parameters (should be safe to comment out this line)
   #endif
+  #if HAS_BINARY_COMMANDS
+    binary = false;                     // Not a binary command
+  #endif
 }
 
 // Populate all fields by parsing a single line of GCode
@@ -98,6 +106,10 @@ void GCodeParser::parse(char *p) {
 
   reset(); // No codes to report
 
+  #if HAS_BINARY_COMMANDS
+    if (*p == BINARY_GCODE_MARK) return parse_binary(p);
+  #endif
+
   // Skip spaces
   while (*p == ' ') ++p;
 
@@ -313,10 +325,322 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+#if ENABLED(FAST_FLOAT_PARSER)
+
+  /**
+   * Read a number ([-+]?[0-9]*.?[0-9]*) to the float strtof would give,
+   * without the locale, exponent, and big number work of strtof. Values of
+   * up to 7 digits take one float divide and up to 19 digits one double
+   * divide. Like value_float() it stops at 'E', not taking it as an exponent.
+   */
+  float GCodeParser::parse_float(char * const str) {
+    static constexpr float pow10f[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+    static constexpr double pow10d[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    char *p = str;
+    const bool neg = *p == '-';
+    if (neg || *p == '+') ++p;
+
+    // The first 19 significant digits as an integer, and the decimal places
+    uint64_t m = 0;
+    uint16_t sig = 0, frac = 0;
+    bool point = false, digits = false;
+    for (;; ++p) {
+      const char c = *p;
+      if (NUMERIC(c)) {
+        digits = true;
+        if ((m || c != '0') && sig++ < 19) m = m * 10 + (c - '0');
+        if (point) ++frac;
+      }
+      else if (c == '.' && !point)
+        point = true;
+      else
+        break;
+    }
+
+    if (sig <= 19) {
+      if (!m) return neg && digits ? -0.0f : 0.0f; // A lone sign is no number, so not -0
+
+      // Both exact in a float, so the divide rounds just once
+      if (m < (1UL << 24) && frac < COUNT(pow10f)) {
+        const float f = float(m) / pow10f[frac];
+        return neg ? -f : f;
+      }
+
+      // Exact in a double. Rounding to double then float gives the same
+      // float, unless the double lands right between two floats.
+      if (m <= (1ULL << 53) && frac < COUNT(pow10d)) {
+        const double d = double(m) / pow10d[frac];
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        if ((bits & 0x1FFFFFFFUL) != 0x10000000UL) {
+          const float f = float(d);
+          return neg ? -f : f;
+        }
+      }
+    }
+
+    // Leave the rare long or halfway value to strtof
+    const char c = *p;
+    *p = '\0';
+    const float f = strtof(str, nullptr);
+    *p = c;
+    return f;
+  }
+
+#endif // FAST_FLOAT_PARSER
+
+#if HAS_BINARY_COMMANDS
+
+  /**
+   * Set the command and parameter values from a pre-tokenized command
+   * (see parser.h). The values are converted to float here, once, so
+   * seen() and value_float() don't have to scan any text.
+   */
+  void GCodeParser::parse_binary(char * const p) {
+    command_ptr = p;
+    binary = true;
+
+    const uint8_t *b = (uint8_t*)p + 1;
+    const uint8_t * const end = b + 1 + *b;
+    ++b;
+
+    const uint8_t letter = *b++;
+    command_letter = letter & 0x7F;
+    codenum = b[0] | (b[1] << 8);
+    b += 2;
+    if (TEST(letter, 7)) {
+      #if USE_GCODE_SUBCODES
+        subcode = *b;
+      #endif
+      ++b;
+    }
+
+    #if ENABLED(GCODE_MOTION_MODES)
+      if (command_letter == 'G' && (codenum <= GTOP || codenum == 5
+                                      #if ENABLED(G38_PROBE_TARGET)
+                                        || codenum == 38
+                                      #endif
+                                   )
+      ) {
+        motion_mode_codenum = codenum;
+        #if USE_GCODE_SUBCODES
+          motion_mode_subcode = subcode;
+        #endif
+      }
+    #endif
+
+    while (b < end) {
+      const uint8_t ind = *b & 0x1F, type = *b++ >> 5;
+      if (ind >= COUNT(param)) {
+        if (ind != BINARY_GCODE_LINE) return; // Corrupt record
+        b += 4;                               // Line number, for "ok"
+        continue;
+      }
+      float v;
+      switch (type) {
+        default:
+        case BINVAL_NONE:    param[ind] = 0; SBI32(codebits, ind); continue;
+        case BINVAL_INT8:    v = (int8_t)b[0]; b += 1; break;
+        case BINVAL_INT16:   v = (int16_t)(b[0] | (b[1] << 8)); b += 2; break;
+        case BINVAL_MILLI16: v = (int16_t)(b[0] | (b[1] << 8)) / 1000.0f; b += 2; break;
+        case BINVAL_INT24:
+        case BINVAL_MILLI24:
+        case BINVAL_E5_24: {
+          const int32_t i = (int32_t)((uint32_t)(b[0] | (b[1] << 8) | ((uint32_t)b[2] << 16)) << 8) >> 8;
+          b += 3;
+          v = type == BINVAL_INT24 ? i : i / (type == BINVAL_MILLI24 ? 1000.0f : 100000.0f);
+        } break;
+        case BINVAL_FLOAT:   memcpy(&v, b, sizeof(v)); b += sizeof(v); break;
+      }
+      binval[ind] = v;
+      param[ind] = 1;                         // Has a value
+      SBI32(codebits, ind);
+    }
+  }
+
+#endif // HAS_BINARY_COMMANDS
+
+#if ENABLED(COMPACT_COMMAND_QUEUE)
+
+  // Append the 'n' low bytes of 'v', little-endian
+  static char* put_bytes(char *o, uint32_t v, uint8_t n) {
+    for (; n; --n, v >>= 8) *o++ = char(v);
+    return o;
+  }
+
+  /**
+   * Tokenize a G-code line as it's queued, as gcode2bin.py does for files.
+   * Only G, M, and T commands with numeric parameters are tokenized, each
+   * value only if parse_binary() will give the same float value_float()
+   * would read from the text, and the same value_long(). All else is kept
+   * as text to be parsed when it runs. The parser state isn't touched, so
+   * this is safe to call while a command is running.
+   */
+  uint8_t GCodeParser::tokenize(const char *p, char * const out) {
+    char *o = out + 2;                          // After the mark and length
+    const char * const oend = out + MAX_CMD_SIZE - 1;
+
+    while (*p == ' ') ++p;
+
+    // Line number, kept only for ADVANCED_OK as "ok" echoes it
+    int32_t line = -1;
+    if (*p == 'N' && NUMERIC_SIGNED(p[1])) {
+      ++p;
+      if (!NUMERIC(*p) || (*p == '0' && NUMERIC(p[1]))) return 0;
+      line = 0;
+      for (uint8_t d = 0; NUMERIC(*p); ++d) {
+        if (d > 8) return 0;
+        line = line * 10 + (*p++ - '0');
+      }
+      if (NUMERIC_SIGNED(*p)) return 0;
+      while (*p == ' ') ++p;
+    }
+    UNUSED(line);
+
+    // Ignore the checksum and trailing spaces
+    const char *end = strchr(p, '*');
+    if (!end) end = p + strlen(p);
+    while (end > p && end[-1] == ' ') --end;
+
+    const char letter = *p++;
+    if (letter != 'G' && letter != 'M' && letter != 'T') return 0;
+    while (*p == ' ') ++p;
+    if (!NUMERIC(*p)) return 0;
+
+    uint32_t code = 0;
+    do {
+      code = code * 10 + (*p++ - '0');
+      if (code > 0xFFFF) return 0;
+    } while (NUMERIC(*p));
+
+    int16_t sub = -1;
+    if (*p == '.') {
+      #if USE_GCODE_SUBCODES
+        ++p;
+        sub = 0;
+        while (NUMERIC(*p)) {
+          sub = sub * 10 + (*p++ - '0');
+          if (sub > 255) return 0;
+        }
+      #else
+        return 0;
+      #endif
+    }
+
+    // Commands that take a string, or another command
+    if (letter == 'M') switch (code) {
+      #if ENABLED(GCODE_MACROS)
+        case 810 ... 819:
+      #endif
+      #if ENABLED(EXPECTED_PRINTER_CHECK)
+        case 16:
+      #endif
+      case 23: case 28: case 30: case 32: case 117: case 118: case 928: return 0;
+      default: break;
+    }
+    #if ENABLED(CNC_COORDINATE_SYSTEMS)
+      if (letter == 'G' && code == 53) return 0;
+    #endif
+
+    *o++ = letter | (sub >= 0 ? 0x80 : 0);
+    o = put_bytes(o, code, 2);
+    if (sub >= 0) *o++ = sub;
+    #if ENABLED(ADVANCED_OK)
+      if (line >= 0) {
+        *o++ = BINARY_GCODE_LINE;
+        o = put_bytes(o, line, 4);
+      }
+    #endif
+
+    uint32_t bits = 0;
+    while (*p == ' ') ++p;
+    while (p < end) {
+      const char c = *p++;
+      if (!WITHIN(c, 'A', 'Z')) return 0;
+      const uint8_t ind = LETTER_BIT(c);
+      if (TEST32(bits, ind)) return 0;          // A repeated parameter
+      SBI32(bits, ind);
+      if (oend - o < 5) return 0;               // Too long for a command slot
+
+      while (*p == ' ') ++p;
+
+      if (!valid_float(p)) {
+        if (letter != 'G') return 0;            // M0, M1, etc. use the string
+        *o++ = ind;                             // BINVAL_NONE
+        if (!WITHIN(*p, 'A', 'Z')) {
+          while (DECIMAL_SIGNED(*p)) ++p;
+          while (*p == ' ') ++p;
+        }
+        continue;
+      }
+
+      char num[16];
+      uint8_t n = 0;
+      while (DECIMAL_SIGNED(*p)) {
+        if (n >= COUNT(num) - 1) return 0;
+        num[n++] = *p++;
+      }
+      num[n] = '\0';
+      while (*p == ' ') ++p;
+
+      const float f =
+        #if ENABLED(FAST_FLOAT_PARSER)
+          parse_float(num)
+        #else
+          strtof(num, nullptr)
+        #endif
+      ;
+      const int32_t l = strtol(num, nullptr, 10);
+      if (float(l) == f && WITHIN(l, -0x800000L, 0x7FFFFFL)) {
+        const uint8_t w = WITHIN(l, -0x80L, 0x7FL) ? 1 : WITHIN(l, -0x8000L, 0x7FFFL) ? 2 : 3;
+        *o++ = ind | (w == 1 ? BINVAL_INT8 : w == 2 ? BINVAL_INT16 : BINVAL_INT24) << 5;
+        o = put_bytes(o, l, w);
+        continue;
+      }
+
+      if (int32_t(f) != l || !(ABS(f) < 16777216.0f)) return 0;
+
+      if (ABS(f) < 8388.0f) {
+        const int32_t m = LROUND(f * 1000.0f);
+        if (m / 1000.0f == f) {
+          const bool w16 = WITHIN(m, -0x8000L, 0x7FFFL);
+          *o++ = ind | (w16 ? BINVAL_MILLI16 : BINVAL_MILLI24) << 5;
+          o = put_bytes(o, m, w16 ? 2 : 3);
+          continue;
+        }
+      }
+      if (ABS(f) < 83.0f) {
+        const int32_t u = LROUND(f * 100000.0f);
+        if (u / 100000.0f == f) {
+          *o++ = ind | BINVAL_E5_24 << 5;
+          o = put_bytes(o, u, 3);
+          continue;
+        }
+      }
+      *o++ = ind | BINVAL_FLOAT << 5;
+      memcpy(o, &f, sizeof(f));
+      o += sizeof(f);
+    }
+
+    const uint8_t len = o - out - 2;
+    out[0] = BINARY_GCODE_MARK;
+    out[1] = len;
+    return len + 2;
+  }
+
+#endif // COMPACT_COMMAND_QUEUE
+
 #if ENABLED(CNC_COORDINATE_SYSTEMS)
 
   // Parse the next parameter as a new command
   bool GCodeParser::chain() {
+    #if HAS_BINARY_COMMANDS
+      if (binary) return false;               // Never more than one binary command
+    #endif
     #if ENABLED(FASTER_GCODE_PARSER)
       char *next_command = command_ptr;
       if (next_command) {
@@ -335,6 +659,14 @@ void GCodeParser::parse(char *p) {
 
 void GCodeParser::unknown_command_error() {
   SERIAL_ECHO_START();
+  #if HAS_BINARY_COMMANDS
+    if (binary) {
+      SERIAL_ECHOPAIR(MSG_UNKNOWN_COMMAND, command_letter);
+      SERIAL_ECHO(codenum);
+      SERIAL_ECHOLNPGM("\"");
+      return;
+    }
+  #endif
   SERIAL_ECHOLNPAIR(MSG_UNKNOWN_COMMAND, command_ptr, "\"");
 }
 
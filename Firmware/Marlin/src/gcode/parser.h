@@ -42,6 +42,30 @@
   typedef enum : uint8_t { LINEARUNIT_MM, LINEARUNIT_INCH } LinearUnit;
 #endif
 
+#if HAS_BINARY_COMMANDS
+  /**
+   * A pre-tokenized command (from gcode2bin.py or COMPACT_COMMAND_QUEUE)
+   * is queued as BINARY_GCODE_MARK, the length of the body, then the body:
+   *  - Command letter. Bit 7 is set if a subcode byte follows the number.
+   *  - Command number (uint16, little-endian) and the optional subcode.
+   *  - For each parameter, a byte with the letter (bits 0-4, A=0) and the
+   *    value type (bits 5-7), followed by the value (little-endian).
+   *    Index BINARY_GCODE_LINE is the host line number, as an int32.
+   */
+  #define BINARY_GCODE_MARK 0x01
+  #define BINARY_GCODE_LINE 26
+  typedef enum : uint8_t {
+    BINVAL_NONE,      // No value
+    BINVAL_INT8,      // Integers
+    BINVAL_INT16,
+    BINVAL_INT24,
+    BINVAL_MILLI16,   // Thousandths
+    BINVAL_MILLI24,
+    BINVAL_E5_24,     // Hundred-thousandths
+    BINVAL_FLOAT      // IEEE single
+  } BinaryValueType;
+#endif
+
 /**
  * GCode parser
  *
@@ -66,6 +90,11 @@ private:
     static char *command_args;      // Args start here, for slow scan
   #endif
 
+  #if HAS_BINARY_COMMANDS
+    static bool binary;             // The command was pre-tokenized
+    static float binval[26];        // For A-Z, the values of a binary command
+  #endif
+
 public:
 
   // Global states for GCode-level units features
@@ -142,6 +171,9 @@ public:
       if (ind >= COUNT(param)) return false; // Only A-Z
       const bool b = TEST32(codebits, ind);
       if (b) {
+        #if HAS_BINARY_COMMANDS
+          if (binary) { value_ptr = param[ind] ? (char*)&binval[ind] : nullptr; return b; }
+        #endif
         char * const ptr = command_ptr + param[ind];
         value_ptr = param[ind] && valid_float(ptr) ? ptr : nullptr;
       }
@@ -212,6 +244,16 @@ public:
   // This uses 54 bytes of SRAM to speed up seen/value
   static void parse(char * p);
 
+  #if HAS_BINARY_COMMANDS
+    // Populate all fields from a pre-tokenized command
+    static void parse_binary(char * const p);
+  #endif
+
+  #if ENABLED(COMPACT_COMMAND_QUEUE)
+    // Tokenize a G-code line into 'out'. Return its size, or 0 to keep the text.
+    static uint8_t tokenize(const char *p, char * const out);
+  #endif
+
   #if ENABLED(CNC_COORDINATE_SYSTEMS)
     // Parse the next parameter as a new command
     static bool chain();
@@ -223,29 +265,52 @@ public:
   // Seen a parameter with a value
   static inline bool seenval(const char c) { return seen(c) && has_value(); }
 
+  #if ENABLED(FAST_FLOAT_PARSER)
+    static float parse_float(char * const str);
+  #endif
+
   // Float removes 'E' to prevent scientific notation interpretation
   static inline float value_float() {
-    if (value_ptr) {
-      char *e = value_ptr;
-      for (;;) {
-        const char c = *e;
-        if (c == '\0' || c == ' ') break;
-        if (c == 'E' || c == 'e') {
-          *e = '\0';
-          const float ret = strtof(value_ptr, nullptr);
-          *e = c;
-          return ret;
+    #if HAS_BINARY_COMMANDS
+      if (binary) return value_ptr ? *(float*)value_ptr : 0;
+    #endif
+    #if ENABLED(FAST_FLOAT_PARSER)
+      return value_ptr ? parse_float(value_ptr) : 0;
+    #else
+      if (value_ptr) {
+        char *e = value_ptr;
+        for (;;) {
+          const char c = *e;
+          if (c == '\0' || c == ' ') break;
+          if (c == 'E' || c == 'e') {
+            *e = '\0';
+            const float ret = strtof(value_ptr, nullptr);
+            *e = c;
+            return ret;
+          }
+          ++e;
         }
-        ++e;
+        return strtof(value_ptr, nullptr);
       }
-      return strtof(value_ptr, nullptr);
-    }
-    return 0;
+      return 0;
+    #endif
   }
 
   // Code value as a long or ulong
-  static inline int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
-  static inline uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  #if HAS_BINARY_COMMANDS
+    // Binary values are exact in a float. Truncate, as strtol does.
+    static inline int32_t value_long() {
+      if (binary) return value_ptr ? (int32_t)*(float*)value_ptr : 0L;
+      return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L;
+    }
+    static inline uint32_t value_ulong() {
+      if (binary) return value_ptr ? (uint32_t)(int32_t)*(float*)value_ptr : 0UL;
+      return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL;
+    }
+  #else
+    static inline int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
+    static inline uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  #endif
 
   // Code value for use as time
   static inline millis_t value_millis() { return value_ulong(); }
@@ -47,6 +47,10 @@ GCodeQueue queue;
   #include "../feature/power_loss_recovery.h"
 #endif
 
+#if ENABLED(BUFFER_MONITORING)
+  #include "../feature/buffer_monitor.h"
+#endif
+
 /**
  * GCode line number handling. Hosts may opt to include line numbers when
  * sending commands to Marlin, and lines will be checked for sequentiality.
@@ -67,7 +71,13 @@ uint8_t GCodeQueue::length = 0,  // Count of commands in the queue
         GCodeQueue::index_r = 0, // Ring buffer read position
         GCodeQueue::index_w = 0; // Ring buffer write position
 
-char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
+#if ENABLED(COMPACT_COMMAND_QUEUE)
+  char GCodeQueue::command_buffer[COMMAND_QUEUE_BYTES];
+  uint16_t GCodeQueue::command_pos[BUFSIZE],
+           GCodeQueue::write_pos;
+#else
+  char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
+#endif
 
 /*
  * The port that the command was received on
@@ -111,6 +121,91 @@ void GCodeQueue::clear() {
   index_r = index_w = length = 0;
 }
 
+#if ENABLED(COMPACT_COMMAND_QUEUE)
+
+  /**
+   * There's room for another command if a whole MAX_CMD_SIZE line fits
+   * after the newest command, or else at the start of the buffer, before
+   * the oldest. The next command's position is set, ready to fill.
+   */
+  bool GCodeQueue::full() {
+    if (length >= BUFSIZE) return true;
+    if (!length)
+      write_pos = 0;
+    else {
+      const uint16_t oldest = command_pos[index_r];
+      if (write_pos > oldest) {
+        if (write_pos + MAX_CMD_SIZE > COMMAND_QUEUE_BYTES) {
+          if (MAX_CMD_SIZE >= oldest) return true;
+          write_pos = 0;
+        }
+      }
+      else if (write_pos + MAX_CMD_SIZE >= oldest)
+        return true;
+    }
+    command_pos[index_w] = write_pos;
+    return false;
+  }
+
+  /**
+   * Count the MAX_CMD_SIZE lines that fit as full() places them. Most take
+   * far less room once packed, so more commands usually fit.
+   */
+  uint8_t GCodeQueue::free_slots() {
+    const uint8_t free_cmds = BUFSIZE - length;
+    if (!length) return _MIN(free_cmds, (COMMAND_QUEUE_BYTES) / (MAX_CMD_SIZE));
+    const uint16_t oldest = command_pos[index_r];
+    uint16_t lines;
+    if (write_pos > oldest)
+      lines = (COMMAND_QUEUE_BYTES - write_pos) / (MAX_CMD_SIZE) + (oldest ? (oldest - 1) / (MAX_CMD_SIZE) : 0);
+    else
+      lines = write_pos < oldest ? (oldest - write_pos - 1) / (MAX_CMD_SIZE) : 0;
+    return _MIN(free_cmds, lines);
+  }
+
+  // After an M28 is queued the commands for the file stay as text
+  static bool keep_text; // = false
+
+  /**
+   * Put a command at 'out', tokenized if it can be, and return the bytes
+   * it takes up in the buffer. A command read from SD is already at 'out'.
+   * Tokens can take more room than the text they come from, so that one is
+   * tokenized from a copy. Serial and injected commands don't need the copy.
+   */
+  static uint16_t pack_command(char * const out, const char *cmd) {
+    if (cmd == out && *cmd == BINARY_GCODE_MARK) return 2 + uint8_t(cmd[1]); // From a binary file
+    #if ENABLED(SDSUPPORT)
+      const char * const m28 = strstr_P(cmd, PSTR("M28"));
+      if (card.flag.saving || (m28 && !NUMERIC(m28[3]))) keep_text = true;
+    #endif
+    char copy[MAX_CMD_SIZE];
+    if (!keep_text) {
+      if (cmd == out) cmd = strcpy(copy, cmd);
+      const uint8_t n = parser.tokenize(cmd, out);
+      if (n) return n;
+    }
+    if (cmd != out) strcpy(out, cmd);           // Keep it as text
+    return strlen(out) + 1;
+  }
+
+#endif
+
+#if ENABLED(BUFFER_MONITORING)
+
+  // A G0-G3 move, after the line number if any
+  static bool is_move(const char *cmd) {
+    #if HAS_BINARY_COMMANDS
+      if (*cmd == BINARY_GCODE_MARK) return (cmd[2] & 0x7F) == 'G' && !cmd[4] && uint8_t(cmd[3]) <= 3;
+    #endif
+    if (*cmd == 'N') {
+      do ++cmd; while (NUMERIC(*cmd));
+      while (*cmd == ' ') ++cmd;
+    }
+    return cmd[0] == 'G' && WITHIN(cmd[1], '0', '3') && !NUMERIC(cmd[2]);
+  }
+
+#endif
+
 /**
  * Once a new command is in the ring buffer, call this to commit it
  */
@@ -119,15 +214,25 @@ void GCodeQueue::_commit_command(bool say_ok
     , int16_t p/*=-1*/
   #endif
 ) {
-  send_ok[index_w] = say_ok;
+  const uint8_t i = index_w;
+  send_ok[i] = say_ok;
   #if NUM_SERIAL > 1
-    port[index_w] = p;
+    port[i] = p;
   #endif
   #if ENABLED(POWER_LOSS_RECOVERY)
-    recovery.commit_sdpos(index_w);
+    recovery.commit_sdpos(i);
   #endif
   if (++index_w >= BUFSIZE) index_w = 0;
   length++;
+
+  #if ENABLED(BUFFER_MONITORING)
+    // Short of moves? Say "ok" to a move as soon as it's queued, so the host
+    // sends the next line now instead of after the move is planned.
+    if (say_ok && free_slots() && is_move(command(i)) && buffer_monitor.starving()) {
+      ok_to_send(i);
+      send_ok[i] = false;
+    }
+  #endif
 }
 
 /**
@@ -140,8 +245,12 @@ bool GCodeQueue::_enqueue(const char* cmd, bool say_ok/*=false*/
     , int16_t pn/*=-1*/
   #endif
 ) {
-  if (*cmd == ';' || length >= BUFSIZE) return false;
-  strcpy(command_buffer[index_w], cmd);
+  if (*cmd == ';' || full()) return false;
+  #if ENABLED(COMPACT_COMMAND_QUEUE)
+    write_pos += pack_command(command(index_w), cmd);
+  #else
+    strcpy(command(index_w), cmd);
+  #endif
   _commit_command(say_ok
     #if NUM_SERIAL > 1
       , pn
@@ -238,16 +347,27 @@ void GCodeQueue::enqueue_now_P(PGM_P const pgcode) {
  *   P<int>  Planner space remaining
  *   B<int>  Block queue space remaining
  */
-void GCodeQueue::ok_to_send() {
+void GCodeQueue::ok_to_send(const uint8_t i/*=index_r*/) {
   #if NUM_SERIAL > 1
-    const int16_t pn = port[index_r];
+    const int16_t pn = port[i];
     if (pn < 0) return;
     PORT_REDIRECT(pn);                    // Reply to the serial port that sent the command
   #endif
-  if (!send_ok[index_r]) return;
+  if (!send_ok[i]) return;
   SERIAL_ECHOPGM(MSG_OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command_buffer[index_r];
+    char* p = command(i);
+    #if ENABLED(COMPACT_COMMAND_QUEUE)
+      if (*p == BINARY_GCODE_MARK) {
+        const char * const n = p + (TEST(p[2], 7) ? 6 : 5);
+        if (n < p + 2 + uint8_t(p[1]) && *n == BINARY_GCODE_LINE) {
+          int32_t line;
+          memcpy(&line, n + 1, sizeof(line));
+          SERIAL_ECHOPAIR(" N", line);
+        }
+      }
+      else
+    #endif
     if (*p == 'N') {
       SERIAL_ECHO(' ');
       SERIAL_ECHO(*p++);
@@ -255,7 +375,7 @@ void GCodeQueue::ok_to_send() {
         SERIAL_ECHO(*p++);
     }
     SERIAL_ECHOPGM(" P"); SERIAL_ECHO(int(BLOCK_BUFFER_SIZE - planner.movesplanned() - 1));
-    SERIAL_ECHOPGM(" B"); SERIAL_ECHO(BUFSIZE - length);
+    SERIAL_ECHOPGM(" B"); SERIAL_ECHO(int(free_slots()));
   #endif
   SERIAL_EOL();
 }
@@ -349,7 +469,7 @@ void GCodeQueue::get_serial_commands() {
   /**
    * Loop while serial characters are incoming and the queue is not full
    */
-  while (length < BUFSIZE && serial_data_available()) {
+  while (!full() && serial_data_available()) {
     for (uint8_t i = 0; i < NUM_SERIAL; ++i) {
       int c;
       if ((c = read_serial(i)) < 0) continue;
@@ -485,6 +605,48 @@ void GCodeQueue::get_serial_commands() {
 
 #if ENABLED(SDSUPPORT)
 
+  #if ENABLED(BINARY_GCODE)
+
+    /**
+     * Read the next record of a pre-tokenized file into a command slot.
+     * A record is its length, then 0 and the text of a command, or the
+     * body of a tokenized command (see parser.h). A length of 0 is a '#'.
+     * Text from a ';' or line break on is a comment, so the print area
+     * header that gcode2bin.py puts in a text record is skipped.
+     * Set 'count' to the length stored in 'cmd' and return the character
+     * that ends the same command in a G-code file, or -1 on a read error.
+     */
+    static int16_t get_sd_record(char * const cmd, uint16_t &count) {
+      count = 0;
+      const int16_t len = card.get();
+      if (len <= 0) return len ? -1 : '#';
+
+      const int16_t kind = card.get();
+      if (kind < 0) return -1;
+      uint16_t n = 0;
+      bool comment = false;
+      if (kind) {
+        if (len > MAX_CMD_SIZE - 3) {           // Too long for a command slot
+          for (int16_t i = 1; i < len; i++) card.get();
+          SERIAL_ERROR_MSG("Binary command too long");
+          return '\n';
+        }
+        cmd[n++] = BINARY_GCODE_MARK;
+        cmd[n++] = len;
+        cmd[n++] = kind;
+      }
+      for (int16_t i = 1; i < len; i++) {
+        const int16_t c = card.get();
+        if (c < 0) return -1;                   // Drop a partial command
+        if (!kind && (c == ';' || c == '\n')) comment = true;
+        if (!comment && n < MAX_CMD_SIZE - 1) cmd[n++] = c;
+      }
+      count = n;
+      return '\n';
+    }
+
+  #endif
+
   /**
    * Get commands from the SD Card until the command buffer is full
    * or until the end of the file is reached. The special character '#'
@@ -500,6 +662,10 @@ void GCodeQueue::get_serial_commands() {
 
     if (!IS_SD_PRINTING()) return;
 
+    #if ENABLED(SD_READ_AHEAD)
+      card.read_ahead(); // Keep the next blocks coming in
+    #endif
+
     /**
      * '#' stops reading from SD to the buffer prematurely, so procedural
      * macro calls are possible. If it occurs, stop_buffering is triggered
@@ -511,8 +677,12 @@ void GCodeQueue::get_serial_commands() {
 
     uint16_t sd_count = 0;
     bool card_eof = card.eof();
-    while (length < BUFSIZE && !card_eof && !stop_buffering) {
-      const int16_t n = card.get();
+    while (!full() && !card_eof && !stop_buffering) {
+      #if ENABLED(BINARY_GCODE)
+        const int16_t n = card.flag.binary_gcode ? get_sd_record(command(index_w), sd_count) : card.get();
+      #else
+        const int16_t n = card.get();
+      #endif
       char sd_char = (char)n;
       card_eof = card.eof();
       if (card_eof || n == -1
@@ -558,13 +728,17 @@ void GCodeQueue::get_serial_commands() {
         // Skip empty lines and comments
         if (!sd_count) { thermalManager.manage_heater(); continue; }
 
-        command_buffer[index_w][sd_count] = '\0'; // terminate string
+        command(index_w)[sd_count] = '\0'; // terminate string
         sd_count = 0; // clear sd line buffer
 
+        #if ENABLED(COMPACT_COMMAND_QUEUE)
+          write_pos += pack_command(command(index_w), command(index_w));
+        #endif
+
         _commit_command(false);
 
         #if ENABLED(POWER_LOSS_RECOVERY)
-          recovery.cmd_sdpos = card.getIndex(); // Prime for the next _commit_command
+          recovery.cmd_sdpos = card.getResumeIndex(); // Prime for the next _commit_command
         #endif
       }
       else if (sd_count >= MAX_CMD_SIZE - 1) {
@@ -574,7 +748,12 @@ void GCodeQueue::get_serial_commands() {
          */
       }
       else {
-        if (sd_char == ';') sd_comment_mode = true;
+        if (sd_char == ';') {
+          sd_comment_mode = true;
+          #if ENABLED(SD_BLOCK_READER)
+            card.skip_line(); // Nothing more to look at until the end of the line
+          #endif
+        }
         #if ENABLED(PAREN_COMMENTS)
           else if (sd_char == '(') sd_comment_paren_mode = true;
           else if (sd_char == ')') sd_comment_paren_mode = false;
@@ -583,7 +762,7 @@ void GCodeQueue::get_serial_commands() {
           #if ENABLED(PAREN_COMMENTS)
             && ! sd_comment_paren_mode
           #endif
-        ) command_buffer[index_w][sd_count++] = sd_char;
+        ) command(index_w)[sd_count++] = sd_char;
       }
     }
   }
@@ -619,7 +798,7 @@ void GCodeQueue::advance() {
   #if ENABLED(SDSUPPORT)
 
     if (card.flag.saving) {
-      char* command = command_buffer[index_r];
+      char* command = queue.command(index_r);
       if (is_M29(command)) {
         // M29 closes the file
         card.closefile();
@@ -661,4 +840,8 @@ void GCodeQueue::advance() {
     if (++index_r >= BUFSIZE) index_r = 0;
   }
 
+  #if ENABLED(COMPACT_COMMAND_QUEUE)
+    if (!length) keep_text = false;
+  #endif
+
 }
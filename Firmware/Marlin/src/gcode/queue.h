@@ -47,11 +47,22 @@ public:
    * (immediate, serial, sd card) and they are processed sequentially by
    * the main loop. The gcode.process_next_command method parses the next
    * command and hands off execution to individual handler functions.
+   *
+   * With COMPACT_COMMAND_QUEUE the commands are packed back to back in
+   * COMMAND_QUEUE_BYTES, tokenized where possible, and BUFSIZE only
+   * limits how many can be queued.
    */
   static uint8_t length,  // Count of commands in the queue
                  index_r; // Ring buffer read position
 
-  static char command_buffer[BUFSIZE][MAX_CMD_SIZE];
+  #if ENABLED(COMPACT_COMMAND_QUEUE)
+    static char command_buffer[COMMAND_QUEUE_BYTES];
+    static uint16_t command_pos[BUFSIZE]; // Where each command starts
+    static inline char* command(const uint8_t i) { return &command_buffer[command_pos[i]]; }
+  #else
+    static char command_buffer[BUFSIZE][MAX_CMD_SIZE];
+    static inline char* command(const uint8_t i) { return command_buffer[i]; }
+  #endif
 
   /*
    * The port that the command was received on
@@ -89,6 +100,24 @@ public:
    */
   static bool has_commands_queued();
 
+  /**
+   * Check whether there's no room for another command
+   */
+  #if ENABLED(COMPACT_COMMAND_QUEUE)
+    static bool full();
+  #else
+    static inline bool full() { return length >= BUFSIZE; }
+  #endif
+
+  /**
+   * Count the commands sure to fit in the queue, as reported to the host
+   */
+  #if ENABLED(COMPACT_COMMAND_QUEUE)
+    static uint8_t free_slots();
+  #else
+    static inline uint8_t free_slots() { return BUFSIZE - length; }
+  #endif
+
   /**
    * Get the next command in the queue, optionally log it to SD, then dispatch it
    */
@@ -110,8 +139,10 @@ public:
    *   N<int>  Line number of the command, if any
    *   P<int>  Planner space remaining
    *   B<int>  Block queue space remaining
+   *
+   * With BUFFER_MONITORING a move may be acknowledged early, as it's queued.
    */
-  static void ok_to_send();
+  static void ok_to_send(const uint8_t i=index_r);
 
   /**
    * Clear the serial line and request a resend of
@@ -123,6 +154,10 @@ private:
 
   static uint8_t index_w;  // Ring buffer write position
 
+  #if ENABLED(COMPACT_COMMAND_QUEUE)
+    static uint16_t write_pos; // Where the next command goes
+  #endif
+
   static void get_serial_commands();
 
   #if ENABLED(SDSUPPORT)
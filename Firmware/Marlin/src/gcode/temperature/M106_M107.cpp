@@ -26,6 +26,7 @@
 
 #include "../gcode.h"
 #include "../../module/motion.h"
+#include "../../module/planner.h"
 #include "../../module/temperature.h"
 
 #if ENABLED(SINGLENOZZLE)
@@ -54,6 +55,10 @@ void GcodeSuite::M106() {
 
   if (p < _CNT_P) {
 
+    #if ENABLED(SEGMENT_COALESCING)
+      planner.flush_coalesced(); // Moves before this keep the old speed
+    #endif
+
     #if ENABLED(EXTRA_FAN_SPEED)
       const uint16_t t = parser.intval('T');
       if (t > 0) return thermalManager.set_temp_fan_speed(p, t);
@@ -71,6 +76,9 @@ void GcodeSuite::M106() {
  */
 void GcodeSuite::M107() {
   const uint8_t p = parser.byteval('P', _ALT_P);
+  #if ENABLED(SEGMENT_COALESCING)
+    planner.flush_coalesced();
+  #endif
   thermalManager.set_fan_speed(p, 0);
 }
 
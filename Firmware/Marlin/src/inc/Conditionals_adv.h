@@ -147,3 +147,6 @@
 #if SAVED_POSITIONS > 256
   #error "SAVED_POSITIONS must be an integer from 0 to 256."
 #endif
+
+// Commands may be queued pre-tokenized
+#define HAS_BINARY_COMMANDS EITHER(BINARY_GCODE, COMPACT_COMMAND_QUEUE)
@@ -42,6 +42,7 @@
 
 #define HAS_CLASSIC_JERK (ENABLED(CLASSIC_JERK) || IS_KINEMATIC)
 #define HAS_CLASSIC_E_JERK (ENABLED(CLASSIC_JERK) || DISABLED(LIN_ADVANCE))
+#define HAS_ADVANCE_ISR (ENABLED(LIN_ADVANCE) && DISABLED(LA_PRESSURE_SMOOTHING))
 
 /**
  * Axis lengths and center
@@ -1633,7 +1634,10 @@
   #undef AUTO_REPORT_TEMPERATURES
 #endif
 
-#define HAS_AUTO_REPORTING EITHER(AUTO_REPORT_TEMPERATURES, AUTO_REPORT_SD_STATUS)
+#define HAS_AUTO_REPORTING ANY(AUTO_REPORT_TEMPERATURES, AUTO_REPORT_SD_STATUS, STEPPER_ISR_PROFILE, BUFFER_MONITORING)
+
+// Keep the nominal runtime of the planner blocks
+#define HAS_BUFFER_RUNTIME (HAS_SPI_LCD || ENABLED(BUFFER_MONITORING))
 
 /**
  * This setting is also used by M109 when trying to calculate
@@ -894,6 +894,246 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   );
 #endif
 
+/**
+ * Pressure Advance Smoothing
+ */
+#if ENABLED(LA_PRESSURE_SMOOTHING)
+  #if DISABLED(LIN_ADVANCE)
+    #error "LA_PRESSURE_SMOOTHING requires LIN_ADVANCE."
+  #elif ENABLED(MIXING_EXTRUDER)
+    #error "LA_PRESSURE_SMOOTHING is not compatible with MIXING_EXTRUDER."
+  #endif
+  static_assert(WITHIN(LA_SMOOTH_TIME, 0.001, 0.1), "LA_SMOOTH_TIME must be from 0.001 to 0.1.");
+#endif
+
+/**
+ * Precomputed Step Schedule
+ */
+#if ENABLED(STEP_SCHEDULE)
+  #ifndef CPU_32_BIT
+    #error "STEP_SCHEDULE requires a 32-bit processor."
+  #elif !WITHIN(STEP_SCHEDULE_SEGMENTS, 4, 255)
+    #error "STEP_SCHEDULE_SEGMENTS must be from 4 to 255."
+  #elif STEP_SCHEDULE_TOLERANCE < 1
+    #error "STEP_SCHEDULE_TOLERANCE must be 1 or greater."
+  #elif !WITHIN(STEP_SCHEDULE_LOOKAHEAD, 1, 15) || STEP_SCHEDULE_LOOKAHEAD >= BLOCK_BUFFER_SIZE
+    #error "STEP_SCHEDULE_LOOKAHEAD must be from 1 to 15, and less than BLOCK_BUFFER_SIZE."
+  #endif
+#endif
+
+/**
+ * Arc segmentation
+ */
+#ifdef ARC_CHORD_TOLERANCE
+  #ifdef ARC_SEGMENTS_PER_R
+    #error "ARC_CHORD_TOLERANCE and ARC_SEGMENTS_PER_R are incompatible. Enable only one."
+  #endif
+  static_assert(ARC_CHORD_TOLERANCE > 0, "ARC_CHORD_TOLERANCE must be greater than 0.");
+#endif
+#if ENABLED(ARC_JUNCTION_SPEED) && ENABLED(CLASSIC_JERK)
+  #error "ARC_JUNCTION_SPEED requires Junction Deviation. Disable CLASSIC_JERK."
+#endif
+
+/**
+ * Buffer Monitoring
+ */
+#if ENABLED(BUFFER_MONITORING) && !WITHIN(BUFFER_LOW_TIME, 1, 60000)
+  #error "BUFFER_LOW_TIME must be from 1 to 60000 ms."
+#endif
+
+/**
+ * Junction Curvature
+ */
+#if ENABLED(JUNCTION_CURVATURE)
+  #if ENABLED(CLASSIC_JERK)
+    #error "JUNCTION_CURVATURE requires Junction Deviation. Disable CLASSIC_JERK."
+  #endif
+  static_assert(JUNCTION_CURVE_DEVIATION > 0, "JUNCTION_CURVE_DEVIATION must be greater than 0.");
+#endif
+
+/**
+ * S-Curve Lookup Table
+ */
+#if ENABLED(S_CURVE_LOOKUP_TABLE)
+  #if DISABLED(S_CURVE_ACCELERATION)
+    #error "S_CURVE_LOOKUP_TABLE requires S_CURVE_ACCELERATION."
+  #elif !defined(CPU_32_BIT)
+    #error "S_CURVE_LOOKUP_TABLE requires a 32-bit processor."
+  #endif
+#endif
+
+/**
+ * S-Curve Junctions
+ */
+#if ENABLED(S_CURVE_JUNCTIONS)
+  #if DISABLED(S_CURVE_ACCELERATION)
+    #error "S_CURVE_JUNCTIONS requires S_CURVE_ACCELERATION."
+  #elif !defined(CPU_32_BIT)
+    #error "S_CURVE_JUNCTIONS requires a 32-bit processor."
+  #endif
+#endif
+
+/**
+ * SD Block Reader
+ */
+#if ENABLED(SD_BLOCK_READER) && DISABLED(SDSUPPORT)
+  #error "SD_BLOCK_READER requires SDSUPPORT."
+#endif
+#if ENABLED(SD_READ_AHEAD)
+  #if DISABLED(SD_BLOCK_READER)
+    #error "SD_READ_AHEAD requires SD_BLOCK_READER."
+  #elif !defined(TARGET_LPC1768)
+    #error "SD_READ_AHEAD requires an LPC176x board."
+  #elif ENABLED(USB_FLASH_DRIVE_SUPPORT)
+    #error "SD_READ_AHEAD is not compatible with USB_FLASH_DRIVE_SUPPORT."
+  #elif !WITHIN(SD_READ_AHEAD_BLOCKS, 2, 16)
+    #error "SD_READ_AHEAD_BLOCKS must be from 2 to 16."
+  #endif
+  /**
+   * The card stays selected, and the SPI busy, from one loop to the next,
+   * so nothing else may use the SD card's SPI bus.
+   */
+  #if HAS_GRAPHICAL_LCD && (LCD_PINS_D4 == SCK_PIN || LCD_PINS_ENABLE == MOSI_PIN || DOGLCD_SCK == SCK_PIN || DOGLCD_MOSI == MOSI_PIN)
+    #error "SD_READ_AHEAD requires an LCD that doesn't share the SD card's SPI pins."
+  #elif TMC_HAS_SPI && DISABLED(TMC_USE_SW_SPI)
+    #error "SD_READ_AHEAD requires TMC_USE_SW_SPI with SPI TMC drivers."
+  #elif EITHER(HEATER_0_USES_MAX6675, HEATER_1_USES_MAX6675) && !PIN_EXISTS(MAX6675_SCK, MAX6675_DO)
+    #error "SD_READ_AHEAD requires MAX6675 pins apart from the SD card's SPI bus."
+  #endif
+#endif
+#if ENABLED(COMPACT_COMMAND_QUEUE)
+  #if DISABLED(FASTER_GCODE_PARSER)
+    #error "COMPACT_COMMAND_QUEUE requires FASTER_GCODE_PARSER."
+  #elif BUFSIZE > 255
+    #error "BUFSIZE must be 255 or less with COMPACT_COMMAND_QUEUE."
+  #elif MAX_CMD_SIZE < 32
+    #error "COMPACT_COMMAND_QUEUE requires a MAX_CMD_SIZE of 32 or more."
+  #elif MAX_CMD_SIZE > 256
+    #error "COMPACT_COMMAND_QUEUE requires a MAX_CMD_SIZE of 256 or less."
+  #elif COMMAND_QUEUE_BYTES < 2 * (MAX_CMD_SIZE) || COMMAND_QUEUE_BYTES > 65535
+    #error "COMMAND_QUEUE_BYTES must be from 2 * MAX_CMD_SIZE to 65535."
+  #endif
+#endif
+#if ENABLED(BINARY_GCODE)
+  #if DISABLED(SDSUPPORT)
+    #error "BINARY_GCODE requires SDSUPPORT."
+  #elif DISABLED(FASTER_GCODE_PARSER)
+    #error "BINARY_GCODE requires FASTER_GCODE_PARSER."
+  #elif MAX_CMD_SIZE < 32
+    #error "BINARY_GCODE requires a MAX_CMD_SIZE of 32 or more."
+  #endif
+#endif
+
+/**
+ * Input Shaping
+ */
+#if ENABLED(INPUT_SHAPING)
+  #if IS_KINEMATIC || IS_CORE
+    #error "INPUT_SHAPING requires a Cartesian machine."
+  #elif HAS_L64XX
+    #error "INPUT_SHAPING is not compatible with L64XX stepper drivers."
+  #elif ENABLED(I2S_STEPPER_STREAM)
+    #error "INPUT_SHAPING is not compatible with I2S_STEPPER_STREAM."
+  #elif !WITHIN(SHAPING_BUFFER_SIZE, 16, 65535)
+    #error "SHAPING_BUFFER_SIZE must be from 16 to 65535."
+  #endif
+  static_assert((SHAPING_FREQ_X == 0 || SHAPING_FREQ_X >= 1) && (SHAPING_FREQ_Y == 0 || SHAPING_FREQ_Y >= 1), "SHAPING_FREQ_[XY] must be 0 (off) or 1 or more.");
+  static_assert(WITHIN(SHAPING_ZETA_X, 0, 0.99) && WITHIN(SHAPING_ZETA_Y, 0, 0.99), "SHAPING_ZETA_[XY] must be from 0 to 0.99.");
+#endif
+
+/**
+ * Bicubic Leveling
+ */
+#if ENABLED(ABL_BICUBIC)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "ABL_BICUBIC requires AUTO_BED_LEVELING_BILINEAR."
+  #elif ENABLED(ABL_BILINEAR_SUBDIVISION)
+    #error "ABL_BICUBIC and ABL_BILINEAR_SUBDIVISION are incompatible. Enable only one."
+  #elif ENABLED(EXTRAPOLATE_BEYOND_GRID)
+    #error "ABL_BICUBIC is not compatible with EXTRAPOLATE_BEYOND_GRID."
+  #elif IS_CARTESIAN && NONE(SEGMENT_LEVELED_MOVES, LEVELING_STREAM)
+    #error "ABL_BICUBIC requires SEGMENT_LEVELED_MOVES or LEVELING_STREAM on Cartesian machines."
+  #elif !WITHIN(ABL_BICUBIC_CACHE, 1, 16)
+    #error "ABL_BICUBIC_CACHE must be from 1 to 16."
+  #endif
+#endif
+
+/**
+ * Leveling Stream
+ */
+#if ENABLED(LEVELING_STREAM)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "LEVELING_STREAM requires AUTO_BED_LEVELING_BILINEAR."
+  #elif IS_KINEMATIC || IS_CORE
+    #error "LEVELING_STREAM requires a Cartesian machine."
+  #elif ENABLED(SEGMENT_LEVELED_MOVES)
+    #error "LEVELING_STREAM replaces SEGMENT_LEVELED_MOVES. Disable SEGMENT_LEVELED_MOVES."
+  #elif HAS_L64XX
+    #error "LEVELING_STREAM is not compatible with L64XX stepper drivers."
+  #elif !WITHIN(LEVELING_STREAM_RATE, 100, 10000)
+    #error "LEVELING_STREAM_RATE must be from 100 to 10000."
+  #endif
+#endif
+
+/**
+ * Adaptive Probing
+ */
+#if ENABLED(ABL_ADAPTIVE_PROBING)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "ABL_ADAPTIVE_PROBING requires AUTO_BED_LEVELING_BILINEAR."
+  #elif ENABLED(PROBE_MANUALLY)
+    #error "ABL_ADAPTIVE_PROBING is not compatible with PROBE_MANUALLY."
+  #elif IS_KINEMATIC
+    #error "ABL_ADAPTIVE_PROBING is not compatible with kinematic machines."
+  #elif ABL_ADAPTIVE_STRIDE < 2 || (ABL_ADAPTIVE_STRIDE & (ABL_ADAPTIVE_STRIDE - 1))
+    #error "ABL_ADAPTIVE_STRIDE must be a power of 2, from 2 up."
+  #elif ABL_ADAPTIVE_STRIDE >= GRID_MAX_POINTS_X || ABL_ADAPTIVE_STRIDE >= GRID_MAX_POINTS_Y
+    #error "ABL_ADAPTIVE_STRIDE must be less than GRID_MAX_POINTS_X and GRID_MAX_POINTS_Y."
+  #endif
+  static_assert(ABL_ADAPTIVE_THRESHOLD >= 0, "ABL_ADAPTIVE_THRESHOLD must be 0 or greater.");
+#endif
+
+/**
+ * Print Area Probing
+ */
+#if ENABLED(G29_PRINT_AREA)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "G29_PRINT_AREA requires AUTO_BED_LEVELING_BILINEAR."
+  #elif ENABLED(PROBE_MANUALLY)
+    #error "G29_PRINT_AREA is not compatible with PROBE_MANUALLY."
+  #elif !WITHIN(PRINT_AREA_HEADER_BYTES, 64, 65535)
+    #error "PRINT_AREA_HEADER_BYTES must be from 64 to 65535."
+  #endif
+  static_assert(PRINT_AREA_MARGIN >= 0, "PRINT_AREA_MARGIN must be 0 or greater.");
+#endif
+
+/**
+ * Segment Coalescing
+ */
+#if ENABLED(SEGMENT_COALESCING)
+  #if IS_KINEMATIC
+    #error "SEGMENT_COALESCING is not compatible with kinematic machines."
+  #elif !WITHIN(SEGMENT_COALESCE_MAX_MOVES, 2, 255)
+    #error "SEGMENT_COALESCE_MAX_MOVES must be from 2 to 255."
+  #elif !WITHIN(SEGMENT_COALESCE_MIN_QUEUED, 1, BLOCK_BUFFER_SIZE - 1)
+    #error "SEGMENT_COALESCE_MIN_QUEUED must be from 1 to BLOCK_BUFFER_SIZE - 1."
+  #endif
+  static_assert(SEGMENT_COALESCE_TOLERANCE > 0, "SEGMENT_COALESCE_TOLERANCE must be greater than 0.");
+  static_assert(SEGMENT_COALESCE_E_RATIO >= 0, "SEGMENT_COALESCE_E_RATIO must be 0 or greater.");
+  static_assert(SEGMENT_COALESCE_MAX_LENGTH > 0, "SEGMENT_COALESCE_MAX_LENGTH must be greater than 0.");
+#endif
+
+/**
+ * Stepper ISR profiler
+ */
+#if ENABLED(STEPPER_ISR_PROFILE)
+  #if !HAS_CYCLE_COUNTER
+    #error "STEPPER_ISR_PROFILE requires a HAL with a cycle counter (LPC176x or Linux)."
+  #elif !WITHIN(STEPPER_ISR_PROFILE_BINS, 2, 16)
+    #error "STEPPER_ISR_PROFILE_BINS must be from 2 to 16."
+  #endif
+#endif
+
 /**
  * Special tool-changing options
  */
@@ -2396,6 +2636,8 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
 
 #if !BLOCK_BUFFER_SIZE || !IS_POWER_OF_2(BLOCK_BUFFER_SIZE)
   #error "BLOCK_BUFFER_SIZE must be a power of 2."
+#elif BLOCK_BUFFER_SIZE > 128
+  #error "BLOCK_BUFFER_SIZE must be 128 or less."
 #endif
 
 #if ENABLED(LED_CONTROL_MENU) && DISABLED(ULTIPANEL)
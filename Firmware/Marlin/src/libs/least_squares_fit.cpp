@@ -34,7 +34,7 @@
 
 #include "../inc/MarlinConfig.h"
 
-#if ANY(AUTO_BED_LEVELING_UBL, AUTO_BED_LEVELING_LINEAR, Z_STEPPER_ALIGN_KNOWN_STEPPER_POSITIONS)
+#if ANY(AUTO_BED_LEVELING_UBL, AUTO_BED_LEVELING_LINEAR, ABL_ADAPTIVE_PROBING, Z_STEPPER_ALIGN_KNOWN_STEPPER_POSITIONS)
 
 #include "least_squares_fit.h"
 
@@ -0,0 +1,63 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * S-curve lookup table, generated by buildroot/share/scripts/createBezierLookupTable.py
+ *
+ * s(t) = 10t^3 - 15t^4 + 6t^5 at t = i/256, in Q16
+ */
+
+#define BEZIER_TABLE_BITS 8
+
+const uint32_t bezier_lookuptable[257] = {
+      0,     0,     0,     1,     2,     5,     8,    13,
+     19,    27,    37,    49,    63,    79,    99,   121,
+    145,   173,   204,   239,   277,   319,   364,   414,
+    467,   524,   586,   652,   723,   798,   878,   963,
+   1052,  1146,  1246,  1350,  1460,  1574,  1695,  1820,
+   1951,  2087,  2229,  2376,  2529,  2687,  2851,  3021,
+   3196,  3377,  3564,  3757,  3955,  4159,  4369,  4585,
+   4806,  5033,  5266,  5505,  5749,  5999,  6255,  6517,
+   6784,  7057,  7335,  7619,  7909,  8204,  8504,  8810,
+   9121,  9438,  9759, 10086, 10418, 10755, 11098, 11445,
+  11797, 12154, 12515, 12882, 13253, 13628, 14008, 14393,
+  14781, 15174, 15571, 15973, 16378, 16787, 17199, 17616,
+  18036, 18460, 18887, 19317, 19751, 20187, 20627, 21070,
+  21515, 21963, 22414, 22867, 23323, 23781, 24241, 24703,
+  25168, 25634, 26101, 26571, 27042, 27514, 27987, 28462,
+  28938, 29415, 29892, 30370, 30849, 31329, 31808, 32288,
+  32768, 33248, 33728, 34207, 34687, 35166, 35644, 36121,
+  36598, 37074, 37549, 38022, 38494, 38965, 39435, 39902,
+  40368, 40833, 41295, 41755, 42213, 42669, 43122, 43573,
+  44021, 44466, 44909, 45349, 45785, 46219, 46649, 47076,
+  47500, 47920, 48337, 48749, 49158, 49563, 49965, 50362,
+  50755, 51143, 51528, 51908, 52283, 52654, 53021, 53382,
+  53739, 54091, 54438, 54781, 55118, 55450, 55777, 56098,
+  56415, 56726, 57032, 57332, 57627, 57917, 58201, 58479,
+  58752, 59019, 59281, 59537, 59787, 60031, 60270, 60503,
+  60730, 60951, 61167, 61377, 61581, 61779, 61972, 62159,
+  62340, 62515, 62685, 62849, 63007, 63160, 63307, 63449,
+  63585, 63716, 63841, 63962, 64076, 64186, 64290, 64390,
+  64484, 64573, 64658, 64738, 64813, 64884, 64950, 65012,
+  65069, 65122, 65172, 65217, 65259, 65297, 65332, 65363,
+  65391, 65415, 65437, 65457, 65473, 65487, 65499, 65509,
+  65517, 65523, 65528, 65531, 65534, 65535, 65536, 65536,
+  65536,
+};
@@ -37,7 +37,7 @@
  */
 
 // Change EEPROM version if the structure changes
-#define EEPROM_VERSION "V75"
+#define EEPROM_VERSION "V76"
 #define EEPROM_OFFSET 100
 
 // Check the integrity of data offsets.
@@ -347,6 +347,13 @@ typedef struct SettingsDataStruct {
   uint8_t backlash_correction;                          // M425 F
   float backlash_smoothing_mm;                          // M425 S
 
+  //
+  // INPUT_SHAPING
+  //
+  #if ENABLED(INPUT_SHAPING)
+    shaper_settings_t shaper_settings[2];               // M593 X Y F D T
+  #endif
+
   //
   // EXTENSIBLE_UI
   //
@@ -412,6 +419,10 @@ void MarlinSettings::postprocess() {
     stepper.refresh_motor_power();
   #endif
 
+  #if ENABLED(INPUT_SHAPING)
+    stepper.refresh_shaping();
+  #endif
+
   #if ENABLED(FWRETRACT)
     fwretract.refresh_autoretract();
   #endif
@@ -1301,6 +1312,14 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(backlash_smoothing_mm);
     }
 
+    //
+    // Input Shaping
+    //
+    #if ENABLED(INPUT_SHAPING)
+      _FIELD_TEST(shaper_settings);
+      EEPROM_WRITE(stepper.shaper_settings);
+    #endif
+
     //
     // Extensible UI User Data
     //
@@ -2137,6 +2156,14 @@ void MarlinSettings::postprocess() {
         EEPROM_READ(backlash_smoothing_mm);
       }
 
+      //
+      // Input Shaping
+      //
+      #if ENABLED(INPUT_SHAPING)
+        _FIELD_TEST(shaper_settings);
+        EEPROM_READ(stepper.shaper_settings);
+      #endif
+
       //
       // Extensible UI User Data
       //
@@ -2654,6 +2681,15 @@ void MarlinSettings::reset() {
     }
   #endif
 
+  //
+  // Input Shaping
+  //
+
+  #if ENABLED(INPUT_SHAPING)
+    stepper.shaper_settings[X_AXIS] = { SHAPING_FREQ_X, SHAPING_ZETA_X, SHAPING_TYPE_X };
+    stepper.shaper_settings[Y_AXIS] = { SHAPING_FREQ_Y, SHAPING_ZETA_Y, SHAPING_TYPE_Y };
+  #endif
+
   //
   // Motor Current PWM
   //
@@ -3536,6 +3572,15 @@ void MarlinSettings::reset() {
       #endif
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      CONFIG_ECHO_HEADING("Input Shaping:");
+      LOOP_L_N(a, 2) {
+        const shaper_settings_t &ss = stepper.shaper_settings[a];
+        CONFIG_ECHO_START();
+        SERIAL_ECHOLNPAIR("  M593 ", a ? 'Y' : 'X', " F", ss.frequency, " D", ss.zeta, " T", int(ss.type));
+      }
+    #endif
+
     #if HAS_MOTOR_CURRENT_PWM
       CONFIG_ECHO_HEADING("Stepper motor currents:");
       CONFIG_ECHO_START();
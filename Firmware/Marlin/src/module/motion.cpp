@@ -861,13 +861,14 @@ void restore_feedrate_and_scaling() {
    * Prepare a linear move in a Cartesian setup.
    *
    * When a mesh-based leveling system is active, moves are segmented
-   * according to the configuration of the leveling system.
+   * according to the configuration of the leveling system. With
+   * LEVELING_STREAM the Stepper ISR follows the mesh instead.
    *
    * Return true if 'current_position' was set to 'destination'
    */
   inline bool prepare_move_to_destination_cartesian() {
     const float scaled_fr_mm_s = MMS_SCALED(feedrate_mm_s);
-    #if HAS_MESH
+    #if HAS_MESH && DISABLED(LEVELING_STREAM)
       if (planner.leveling_active && planner.leveling_active_at_z(destination.z)) {
         #if ENABLED(AUTO_BED_LEVELING_UBL)
           ubl.line_to_destination_cartesian(scaled_fr_mm_s, active_extruder); // UBL's motion routine needs to know about
@@ -890,7 +891,7 @@ void restore_feedrate_and_scaling() {
           }
         #endif
       }
-    #endif // HAS_MESH
+    #endif // HAS_MESH && !LEVELING_STREAM
 
     planner.buffer_line(destination, scaled_fr_mm_s, active_extruder);
     return false; // caller will update current_position
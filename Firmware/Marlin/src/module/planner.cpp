@@ -120,6 +120,9 @@ Planner planner;
  * A ring buffer of moves described in steps
  */
 block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
+#if HAS_BLOCK_AUX
+  block_aux_t Planner::block_aux[BLOCK_BUFFER_SIZE];
+#endif
 volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be pushed
                  Planner::block_buffer_nonbusy, // Index of the first non-busy block
                  Planner::block_buffer_planned, // Index of the optimally planned block
@@ -127,6 +130,14 @@ volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be
 uint16_t Planner::cleaning_buffer_counter;      // A counter to disable queuing of blocks
 uint8_t Planner::delay_before_delivering;       // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
+#if ENABLED(PLANNER_STATS)
+  planner_stats_t Planner::stats;               // Look-ahead work counters
+#endif
+
+#if ENABLED(SEGMENT_COALESCING)
+  coalesce_t Planner::coalesced;                // Short moves held back for merging
+#endif
+
 planner_settings_t Planner::settings;           // Initialized by settings.load()
 
 uint32_t Planner::max_acceleration_steps_per_s2[XYZE_N]; // (steps/s^2) Derived from mm_per_s2
@@ -135,6 +146,9 @@ float Planner::steps_to_mm[XYZE_N];           // (mm) Millimeters per step
 
 #if DISABLED(CLASSIC_JERK)
   float Planner::junction_deviation_mm;       // (mm) M205 J
+  #if ENABLED(ARC_JUNCTION_SPEED)
+    float Planner::arc_radius; // = 0
+  #endif
   #if ENABLED(LIN_ADVANCE)
     #if ENABLED(DISTINCT_E_FACTORS)
       float Planner::max_e_jerk[EXTRUDERS];   // Calculated from junction_deviation_mm
@@ -203,7 +217,7 @@ xyze_float_t Planner::previous_speed;
 float Planner::previous_nominal_speed_sqr;
 
 #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
-  uint8_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
+  uint16_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
 #endif
 
 #ifdef XY_FREQUENCY_LIMIT
@@ -225,7 +239,7 @@ float Planner::previous_nominal_speed_sqr;
   xyze_pos_t Planner::position_cart;
 #endif
 
-#if HAS_SPI_LCD
+#if HAS_BUFFER_RUNTIME
   volatile uint32_t Planner::block_buffer_runtime_us = 0;
 #endif
 
@@ -781,6 +795,14 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
     block->cruise_rate = cruise_rate;
   #endif
   block->final_rate = final_rate;
+
+  #if ENABLED(STEP_SCHEDULE)
+    stepper.schedule_invalidate(block);
+  #endif
+
+  #if ENABLED(PLANNER_STATS)
+    stats.trapezoids++;
+  #endif
 }
 
 /*                            PLANNER SPEED DEFINITION
@@ -846,7 +868,8 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
 */
 
 // The kernel called by recalculate() when scanning the plan from last to first entry.
-void Planner::reverse_pass_kernel(block_t* const current, const block_t * const next) {
+// Return true if the entry speed of the block was changed.
+bool Planner::reverse_pass_kernel(block_t* const current, const block_t * const next) {
   if (current) {
     // If entry speed is already at the maximum entry speed, and there was no change of speed
     // in the next block, there is no need to recheck. Block is cruising and there is no need to
@@ -887,17 +910,24 @@ void Planner::reverse_pass_kernel(block_t* const current, const block_t * const
           // Block is not BUSY so this is ahead of the Stepper ISR:
           // Just Set the new entry speed.
           current->entry_speed_sqr = new_entry_speed_sqr;
+          return true;
         }
       }
     }
   }
+  return false;
 }
 
 /**
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the reverse pass.
+ *
+ * The speeds of all earlier junctions only depend on the entry speed of the
+ * block after them, so the pass ends at the first block (before the newest)
+ * whose entry speed is left unchanged. Return the index of that block, or of
+ * the planned block, where the forward pass and trapezoid update can begin.
  */
-void Planner::reverse_pass() {
+uint8_t Planner::reverse_pass() {
   // Initialize block index to the last block in the planner buffer.
   uint8_t block_index = prev_block_index(block_buffer_head);
 
@@ -908,20 +938,29 @@ void Planner::reverse_pass() {
   // If there was a race condition and block_buffer_planned was incremented
   //  or was pointing at the head (queue empty) break loop now and avoid
   //  planning already consumed blocks
-  if (planned_block_index == block_buffer_head) return;
+  if (planned_block_index == block_buffer_head) return planned_block_index;
 
   // Reverse Pass: Coarsely maximize all possible deceleration curves back-planning from the last
   // block in buffer. Cease planning when the last optimal planned or tail pointer is reached.
   // NOTE: Forward pass will later refine and correct the reverse pass to create an optimal plan.
   const block_t *next = nullptr;
+  #if ENABLED(PLANNER_STATS)
+    uint8_t visits = 0;
+  #endif
   while (block_index != planned_block_index) {
 
     // Perform the reverse pass
     block_t *current = &block_buffer[block_index];
 
+    #if ENABLED(PLANNER_STATS)
+      stats.reverse_visits++;
+      NOLESS(stats.reverse_max, ++visits);
+    #endif
+
     // Only consider non sync blocks
     if (!TEST(current->flag, BLOCK_BIT_SYNC_POSITION)) {
-      reverse_pass_kernel(current, next);
+      // The newest block always changes the exit speed of the one before it
+      if (!reverse_pass_kernel(current, next) && next) return block_index;
       next = current;
     }
 
@@ -934,12 +973,13 @@ void Planner::reverse_pass() {
     while (planned_block_index != block_buffer_planned) {
 
       // If we reached the busy block or an already processed block, break the loop now
-      if (block_index == planned_block_index) return;
+      if (block_index == planned_block_index) return planned_block_index;
 
       // Advance the pointer, following the busy block
       planned_block_index = next_block_index(planned_block_index);
     }
   }
+  return planned_block_index;
 }
 
 // The kernel called by recalculate() when scanning the plan from first to last entry.
@@ -996,24 +1036,31 @@ void Planner::forward_pass_kernel(const block_t* const previous, block_t* const
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the forward pass.
  */
-void Planner::forward_pass() {
+void Planner::forward_pass(const uint8_t start) {
 
-  // Forward Pass: Forward plan the acceleration curve from the planned pointer onward.
-  // Also scans for optimal plan breakpoints and appropriately updates the planned pointer.
+  // Forward Pass: Forward plan the acceleration curve from the first block left unchanged
+  // by the reverse pass (at worst the planned pointer) onward. Also scans for optimal plan
+  // breakpoints and appropriately updates the planned pointer.
 
-  // Begin at buffer planned pointer. Note that block_buffer_planned can be modified
-  //  by the stepper ISR,  so read it ONCE. It it guaranteed that block_buffer_planned
-  //  will never lead head, so the loop is safe to execute. Also note that the forward
-  //  pass will never modify the values at the tail.
-  uint8_t block_index = block_buffer_planned;
+  // The start block never leads head, so the loop is safe to execute. Also note that
+  // the forward pass will never modify the values at the tail.
+  uint8_t block_index = start;
 
   block_t *block;
   const block_t * previous = nullptr;
+  #if ENABLED(PLANNER_STATS)
+    uint8_t visits = 0;
+  #endif
   while (block_index != block_buffer_head) {
 
     // Perform the forward pass
     block = &block_buffer[block_index];
 
+    #if ENABLED(PLANNER_STATS)
+      stats.forward_visits++;
+      NOLESS(stats.forward_max, ++visits);
+    #endif
+
     // Skip SYNC blocks
     if (!TEST(block->flag, BLOCK_BIT_SYNC_POSITION)) {
       // If there's no previous block or the previous block is not
@@ -1031,14 +1078,22 @@ void Planner::forward_pass() {
 }
 
 /**
- * Recalculate the trapezoid speed profiles for all blocks in the plan
+ * Recalculate the trapezoid speed profiles for the blocks in the plan
  * according to the entry_factor for each junction. Must be called by
- * recalculate() after updating the blocks.
+ * recalculate() after updating the blocks. Junctions before 'start'
+ * are unchanged, so the blocks ending there are left alone.
  */
-void Planner::recalculate_trapezoids() {
+void Planner::recalculate_trapezoids(const uint8_t start) {
   // The tail may be changed by the ISR so get a local copy.
-  uint8_t block_index = block_buffer_tail,
+  const uint8_t tail_block_index = block_buffer_tail;
+  uint8_t block_index = start,
           head_block_index = block_buffer_head;
+
+  // Back up over SYNC blocks to the block ending at the first junction that may have changed
+  while (block_index != tail_block_index
+    && (block_index == head_block_index || TEST(block_buffer[block_index].flag, BLOCK_BIT_SYNC_POSITION))
+  ) block_index = prev_block_index(block_index);
+
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
   // specially handled), scan backwards to the first non-SYNC block.
@@ -1060,10 +1115,18 @@ void Planner::recalculate_trapezoids() {
   // Go from the tail (currently executed block) to the first block, without including it)
   block_t *block = nullptr, *next = nullptr;
   float current_entry_speed = 0.0, next_entry_speed = 0.0;
+  #if ENABLED(PLANNER_STATS)
+    uint8_t visits = 0;
+  #endif
   while (block_index != head_block_index) {
 
     next = &block_buffer[block_index];
 
+    #if ENABLED(PLANNER_STATS)
+      stats.trapezoid_visits++;
+      NOLESS(stats.trapezoid_max, ++visits);
+    #endif
+
     // Skip sync blocks
     if (!TEST(next->flag, BLOCK_BIT_SYNC_POSITION)) {
       next_entry_speed = SQRT(next->entry_speed_sqr);
@@ -1087,7 +1150,7 @@ void Planner::recalculate_trapezoids() {
             const float current_nominal_speed = SQRT(block->nominal_speed_sqr),
                         nomr = 1.0f / current_nominal_speed;
             calculate_trapezoid_for_block(block, current_entry_speed * nomr, next_entry_speed * nomr);
-            #if ENABLED(LIN_ADVANCE)
+            #if HAS_ADVANCE_ISR
               if (block->use_advance_lead) {
                 const float comp = block->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
                 block->max_adv_steps = current_nominal_speed * comp;
@@ -1126,7 +1189,7 @@ void Planner::recalculate_trapezoids() {
       const float next_nominal_speed = SQRT(next->nominal_speed_sqr),
                   nomr = 1.0f / next_nominal_speed;
       calculate_trapezoid_for_block(next, next_entry_speed * nomr, float(MINIMUM_PLANNER_SPEED) * nomr);
-      #if ENABLED(LIN_ADVANCE)
+      #if HAS_ADVANCE_ISR
         if (next->use_advance_lead) {
           const float comp = next->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
           next->max_adv_steps = next_nominal_speed * comp;
@@ -1142,14 +1205,22 @@ void Planner::recalculate_trapezoids() {
 }
 
 void Planner::recalculate() {
+  #if ENABLED(PLANNER_STATS)
+    stats.recalcs++;
+  #endif
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
+  uint8_t start = block_buffer_planned;
   // If there is just one block, no planning can be done. Avoid it!
-  if (block_index != block_buffer_planned) {
-    reverse_pass();
-    forward_pass();
+  if (block_index != start) {
+    start = reverse_pass();
+    forward_pass(start);
   }
-  recalculate_trapezoids();
+  // Still, the new block sets the exit speed of the block before it
+  else if (start != block_buffer_tail)
+    start = prev_block_index(start);
+
+  recalculate_trapezoids(start);
 }
 
 #if ENABLED(AUTOTEMP)
@@ -1203,20 +1274,20 @@ void Planner::check_axes_activity() {
   if (has_blocks_queued()) {
 
     #if FAN_COUNT > 0 || ENABLED(BARICUDA)
-      block_t *block = &block_buffer[block_buffer_tail];
+      const block_aux_t &tail_aux = block_aux[block_buffer_tail];
     #endif
 
     #if FAN_COUNT > 0
       FANS_LOOP(i)
-        tail_fan_speed[i] = thermalManager.scaledFanSpeed(i, block->fan_speed[i]);
+        tail_fan_speed[i] = thermalManager.scaledFanSpeed(i, tail_aux.fan_speed[i]);
     #endif
 
     #if ENABLED(BARICUDA)
       #if HAS_HEATER_1
-        tail_valve_pressure = block->valve_pressure;
+        tail_valve_pressure = tail_aux.valve_pressure;
       #endif
       #if HAS_HEATER_2
-        tail_e_to_p_pressure = block->e_to_p_pressure;
+        tail_e_to_p_pressure = tail_aux.e_to_p_pressure;
       #endif
     #endif
 
@@ -1504,11 +1575,16 @@ void Planner::quick_stop() {
   // Drop all queue entries
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
 
+  #if ENABLED(SEGMENT_COALESCING)
+    // Drop the held moves too
+    coalesced.count = 0;
+  #endif
+
   // Restart the block delay for the first movement - As the queue was
   // forced to empty, there's no risk the ISR will touch this.
   delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
 
-  #if HAS_SPI_LCD
+  #if HAS_BUFFER_RUNTIME
     // Clear the accumulated runtime
     clear_block_buffer_runtime();
   #endif
@@ -1533,7 +1609,20 @@ float Planner::triggered_position_mm(const AxisEnum axis) {
 }
 
 void Planner::finish_and_disable() {
-  while (has_blocks_queued() || cleaning_buffer_counter) idle();
+  #if ENABLED(SEGMENT_COALESCING)
+    flush_coalesced();
+  #endif
+  while (has_blocks_queued() || cleaning_buffer_counter
+    #if ENABLED(INPUT_SHAPING)
+      || stepper.input_shaping_busy()
+    #endif
+    #if ENABLED(LEVELING_STREAM)
+      || stepper.leveling_stream_busy()
+    #endif
+    #if ENABLED(LA_PRESSURE_SMOOTHING)
+      || stepper.pressure_busy()
+    #endif
+  ) idle();
   disable_all_steppers();
 }
 
@@ -1572,8 +1661,23 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
  * Block until all buffered steps are executed / cleaned
  */
 void Planner::synchronize() {
+  #if ENABLED(SEGMENT_COALESCING)
+    flush_coalesced();
+  #endif
+  #if ENABLED(BUFFER_MONITORING)
+    buffer_monitor.drained = true;  // Running dry is wanted here
+  #endif
   while (
     has_blocks_queued() || cleaning_buffer_counter
+    #if ENABLED(INPUT_SHAPING)
+      || stepper.input_shaping_busy()
+    #endif
+    #if ENABLED(LEVELING_STREAM)
+      || stepper.leveling_stream_busy()
+    #endif
+    #if ENABLED(LA_PRESSURE_SMOOTHING)
+      || stepper.pressure_busy()
+    #endif
     #if ENABLED(EXTERNAL_CLOSED_LOOP_CONTROLLER)
       || (READ(CLOSED_LOOP_ENABLE_PIN) && !READ(CLOSED_LOOP_MOVE_COMPLETE_PIN))
     #endif
@@ -1638,6 +1742,10 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   // Move buffer head
   block_buffer_head = next_buffer_head;
 
+  #if ENABLED(BUFFER_MONITORING)
+    buffer_monitor.block_queued();
+  #endif
+
   // Recalculate and optimize trapezoidal speed profiles
   recalculate();
 
@@ -1876,21 +1984,25 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   // Bail if this is a zero-length block
   if (block->step_event_count < MIN_STEPS_PER_SEGMENT) return false;
 
+  #if HAS_BLOCK_AUX
+    block_aux_t &aux_data = aux(block);
+  #endif
+
   #if ENABLED(MIXING_EXTRUDER)
     MIXER_POPULATE_BLOCK();
   #endif
 
   #if HAS_CUTTER
-    block->cutter_power = cutter.power;
+    aux_data.cutter_power = cutter.power;
   #endif
 
   #if FAN_COUNT > 0
-    FANS_LOOP(i) block->fan_speed[i] = thermalManager.fan_speed[i];
+    FANS_LOOP(i) aux_data.fan_speed[i] = thermalManager.fan_speed[i];
   #endif
 
   #if ENABLED(BARICUDA)
-    block->valve_pressure = baricuda_valve_pressure;
-    block->e_to_p_pressure = baricuda_e_to_p_pressure;
+    aux_data.valve_pressure = baricuda_valve_pressure;
+    aux_data.e_to_p_pressure = baricuda_e_to_p_pressure;
   #endif
 
   #if EXTRUDERS > 1
@@ -1984,7 +2096,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   const uint8_t moves_queued = nonbusy_movesplanned();
 
   // Slow down when the buffer starts to empty, rather than wait at the corner for a buffer refill
-  #if EITHER(SLOWDOWN, ULTRA_LCD) || defined(XY_FREQUENCY_LIMIT)
+  #if EITHER(SLOWDOWN, ULTRA_LCD) || defined(XY_FREQUENCY_LIMIT) || HAS_BUFFER_RUNTIME
     // Segment time im micro seconds
     uint32_t segment_time_us = LROUND(1000000.0f / inverse_secs);
   #endif
@@ -1995,20 +2107,20 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         // buffer is draining, add extra time.  The amount of time added increases if the buffer is still emptied more.
         const uint32_t nst = segment_time_us + LROUND(2 * (settings.min_segment_time_us - segment_time_us) / moves_queued);
         inverse_secs = 1000000.0f / nst;
-        #if defined(XY_FREQUENCY_LIMIT) || HAS_SPI_LCD
+        #if defined(XY_FREQUENCY_LIMIT) || HAS_BUFFER_RUNTIME
           segment_time_us = nst;
         #endif
       }
     }
   #endif
 
-  #if HAS_SPI_LCD
+  #if HAS_BUFFER_RUNTIME
     // Protect the access to the position.
     const bool was_enabled = STEPPER_ISR_ENABLED();
     if (was_enabled) DISABLE_STEPPER_DRIVER_INTERRUPT();
 
     block_buffer_runtime_us += segment_time_us;
-    block->segment_time_us = segment_time_us;
+    aux_data.segment_time_us = segment_time_us;
 
     if (was_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
   #endif
@@ -2199,10 +2311,14 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   }
   block->acceleration_steps_per_s2 = accel;
   block->acceleration = accel / steps_per_mm;
+  #if ENABLED(S_CURVE_JUNCTIONS)
+    block->acceleration_mm = LROUND(block->acceleration);
+    NOLESS(block->acceleration_mm, 1U);
+  #endif
   #if DISABLED(S_CURVE_ACCELERATION)
     block->acceleration_rate = (uint32_t)(accel * (4096.0f * 4096.0f / (STEPPER_TIMER_RATE)));
   #endif
-  #if ENABLED(LIN_ADVANCE)
+  #if HAS_ADVANCE_ISR
     if (block->use_advance_lead) {
       block->advance_speed = (STEPPER_TIMER_RATE) / (extruder_advance_K[active_extruder] * block->e_D_ratio * block->acceleration * settings.axis_steps_per_mm[E_AXIS_N(extruder)]);
       #if ENABLED(LA_DEBUG)
@@ -2212,6 +2328,29 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
           SERIAL_ECHOLNPGM("eISR running at > 10kHz.");
       #endif
     }
+  #elif ENABLED(LA_PRESSURE_SMOOTHING)
+    // The advance is K times the E step rate, which the Stepper ISR gets from the step event rate
+    block->la_coeff = block->use_advance_lead
+      ? extruder_advance_K[active_extruder] * block->steps.e / block->step_event_count * 16777216.0f
+      : 0;
+  #endif
+
+  #if ENABLED(LEVELING_STREAM)
+    /**
+     * The move is leveled at its ends only. Keep the mesh offsets there in
+     * Z steps, so the Stepper ISR can follow the mesh in between.
+     */
+    block->level_scale = 0;
+    if (leveling_active && (block->steps.x || block->steps.y)) {
+      const float scale = fade_scaling_factor_for_z(target.z * steps_to_mm[Z_AXIS]) * settings.axis_steps_per_mm[Z_AXIS];
+      if (scale) {
+        const xy_pos_t start = { position.x * steps_to_mm[X_AXIS], position.y * steps_to_mm[Y_AXIS] },
+                       end = { target.x * steps_to_mm[X_AXIS], target.y * steps_to_mm[Y_AXIS] };
+        block->level_scale = scale;
+        block->level_start = scale * bilinear_z_offset(start);
+        block->level_delta = scale * bilinear_z_offset(end) - block->level_start;
+      }
+    }
   #endif
 
   float vmax_junction_sqr; // Initial limit on the segment entry velocity (mm/s)^2
@@ -2254,6 +2393,14 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     // Unit vector of previous path line segment
     static xyze_float_t prev_unit_vec;
 
+    #if ENABLED(JUNCTION_CURVATURE)
+      // Previous move, and the circle through the previous junction
+      static xyz_float_t prev_move, prev_turn;
+      static float prev_radius; // = 0
+      float radius = 0;
+      xyz_float_t turn{0};
+    #endif
+
     xyze_float_t unit_vec =
       #if IS_KINEMATIC && DISABLED(CLASSIC_JERK)
         delta_mm_cart
@@ -2295,6 +2442,43 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
                     sin_theta_d2 = SQRT(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
 
         vmax_junction_sqr = (junction_acceleration * junction_deviation_mm * sin_theta_d2) / (1.0f - sin_theta_d2);
+
+        #if ENABLED(JUNCTION_CURVATURE)
+          /**
+           * Radius of the circle through the start of the previous move, the junction
+           * and the end of this move. The turn (normal to the plane) tells if the path
+           * keeps bending the same way. The centripetal acceleration at the junction is
+           * along junction_unit_vec, so junction_acceleration holds the per-axis limits.
+           */
+          const xyz_float_t move = { unit_vec.x * block->millimeters, unit_vec.y * block->millimeters, unit_vec.z * block->millimeters };
+          turn.set(prev_move.y * move.z - prev_move.z * move.y,
+                   prev_move.z * move.x - prev_move.x * move.z,
+                   prev_move.x * move.y - prev_move.y * move.x);
+          const float turn_len = turn.magnitude();
+          if (turn_len > 0)
+            radius = (prev_move + move).magnitude() * prev_move.magnitude() * move.magnitude() / (2 * turn_len);
+        #endif
+
+        #if ENABLED(ARC_JUNCTION_SPEED)
+          // Within an arc the chords follow the curve, so use its centripetal speed limit
+          if (arc_radius) vmax_junction_sqr = junction_acceleration * arc_radius;
+          else
+        #endif
+        #if ENABLED(JUNCTION_CURVATURE)
+          if (radius) {
+            // The longer move's gap (sagitta) to the circle, to tell a curve from a corner
+            const float longest = _MAX(prev_move.magnitude(), move.magnitude()),
+                        sagitta = sq(longest) / (8 * radius),
+                        limit_sqr = junction_acceleration * radius;
+            if (prev_radius && sagitta <= (JUNCTION_CURVE_DEVIATION)
+              && prev_turn.x * turn.x + prev_turn.y * turn.y + prev_turn.z * turn.z > 0
+              && ABS(radius - prev_radius) <= 0.25f * _MAX(radius, prev_radius)
+            )
+              vmax_junction_sqr = limit_sqr;      // Along a curve, run at its speed
+            else
+              NOMORE(vmax_junction_sqr, limit_sqr); // Otherwise it's the most for the corner
+          }
+        #else
         if (block->millimeters < 1) {
 
           // Fast acos approximation, minus the error bar to be safe
@@ -2306,6 +2490,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
             NOMORE(vmax_junction_sqr, limit_sqr);
           }
         }
+        #endif
       }
 
       // Get the lowest speed
@@ -2316,6 +2501,12 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
     prev_unit_vec = unit_vec;
 
+    #if ENABLED(JUNCTION_CURVATURE)
+      prev_move.set(unit_vec.x * block->millimeters, unit_vec.y * block->millimeters, unit_vec.z * block->millimeters);
+      prev_turn = turn;
+      prev_radius = radius;
+    #endif
+
   #endif
 
   #ifdef USE_CACHED_SQRT
@@ -2460,7 +2651,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   #endif
 
   #if ENABLED(POWER_LOSS_RECOVERY)
-    block->sdpos = recovery.command_sdpos();
+    aux_data.sdpos = recovery.command_sdpos();
   #endif
 
   // Movement was accepted
@@ -2478,6 +2669,9 @@ void Planner::buffer_sync_block() {
 
   // Clear block
   memset(block, 0, sizeof(block_t));
+  #if HAS_BLOCK_AUX
+    memset(&aux(block), 0, sizeof(block_aux_t));
+  #endif
 
   block->flag = BLOCK_FLAG_SYNC_POSITION;
 
@@ -2498,6 +2692,120 @@ void Planner::buffer_sync_block() {
   stepper.wake_up();
 } // buffer_sync_block()
 
+#if ENABLED(SEGMENT_COALESCING)
+
+  /**
+   * Planner::coalesce_segment
+   *
+   * Merge a move into the run held back from the queue, if it continues the
+   * run in a straight line. The merged line runs from the planner position to
+   * the new target, and every dropped point must lie within the chord tolerance
+   * of it. Otherwise the held run is queued and the move starts a new one.
+   *
+   * Only the last target of a run is ever queued, so the steppers stop on
+   * the same steps as they would for the separate moves.
+   */
+  bool Planner::coalesce_segment(const abce_long_t &target, const xyze_pos_t &target_float,
+    const feedRate_t &fr_mm_s, const uint8_t extruder, const float &millimeters
+  ) {
+    const bool eligible = !millimeters
+      && movesplanned() >= SEGMENT_COALESCE_MIN_QUEUED
+      && !DEBUGGING(DRYRUN)
+      #if ENABLED(CANCEL_OBJECTS)
+        && !cancelable.skipping
+      #endif
+    ;
+
+    const xyz_pos_t end = target_float;
+    coalesce_t &run = coalesced;
+
+    if (run.count) {
+      const xyz_pos_t last = run.target_float;
+      const float length = (end - last).magnitude();
+      if (eligible && run.count < SEGMENT_COALESCE_MAX_MOVES
+        && extruder == run.extruder && fr_mm_s == run.fr_mm_s
+        && WITHIN(length, 0.0001f, SEGMENT_COALESCE_MAX_LENGTH)
+        && ABS((target_float.e - run.target_float.e) / length - run.e_per_mm) <= ABS(run.e_per_mm) * (SEGMENT_COALESCE_E_RATIO)
+      ) {
+        // The new merged line from the run start
+        const xyz_pos_t start = position_float;
+        const xyz_float_t chord = end - start;
+        const float chord_length = chord.magnitude();
+        const xyz_float_t unit = chord * RECIPROCAL(chord_length);
+
+        // Each dropped point must project onto the line and lie near it
+        const auto near_line = [&](const xyz_pos_t &p) {
+          const xyz_float_t v = p - start;
+          const float t = v.x * unit.x + v.y * unit.y + v.z * unit.z;
+          return WITHIN(t, 0, chord_length) && v.x * v.x + v.y * v.y + v.z * v.z - sq(t) <= sq(SEGMENT_COALESCE_TOLERANCE);
+        };
+        bool merge = near_line(last);
+        for (uint8_t i = 0; merge && i < run.count - 1; i++) merge = near_line(run.point[i]);
+
+        if (merge) {
+          run.point[run.count - 1] = last;
+          run.count++;
+          run.target = target;
+          run.target_float = target_float;
+          return true;
+        }
+      }
+      flush_coalesced();
+    }
+
+    if (!eligible) return false;
+
+    // Start a new run with a short move
+    const xyz_pos_t start = position_float;
+    const float length = (end - start).magnitude();
+    if (!WITHIN(length, 0.0001f, SEGMENT_COALESCE_MAX_LENGTH)) return false;
+
+    run.count = 1;
+    run.extruder = extruder;
+    run.fr_mm_s = fr_mm_s;
+    run.e_per_mm = (target_float.e - position_float.e) / length;
+    run.target = target;
+    run.target_float = target_float;
+    #if HAS_CUTTER
+      run.cutter_power = cutter.power;
+    #endif
+    #if FAN_COUNT > 0
+      COPY(run.fan_speed, thermalManager.fan_speed);
+    #endif
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      run.sdpos = recovery.command_sdpos();
+    #endif
+    return true;
+  }
+
+  void Planner::flush_coalesced() {
+    if (!coalesced.count) return;
+    coalesced.count = 0; // Cleared first, since queuing may call idle()
+    #if HAS_COALESCE_AUX
+      const uint8_t head = block_buffer_head;
+    #endif
+    if (_buffer_steps(coalesced.target, coalesced.target_float, coalesced.fr_mm_s, coalesced.extruder)) {
+      #if HAS_COALESCE_AUX
+        // The block gets the state of the first move, not of the flush
+        if (block_buffer_head != head) {
+          block_aux_t &aux_data = aux(&block_buffer[head]);
+          #if HAS_CUTTER
+            aux_data.cutter_power = coalesced.cutter_power;
+          #endif
+          #if FAN_COUNT > 0
+            COPY(aux_data.fan_speed, coalesced.fan_speed);
+          #endif
+          #if ENABLED(POWER_LOSS_RECOVERY)
+            aux_data.sdpos = coalesced.sdpos;
+          #endif
+        }
+      #endif
+      stepper.wake_up();
+    }
+  }
+
+#endif // SEGMENT_COALESCING
+
 /**
  * Planner::buffer_segment
  *
@@ -2523,6 +2831,9 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
   // When changing extruders recalculate steps corresponding to the E position
   #if ENABLED(DISTINCT_E_FACTORS)
     if (last_extruder != extruder && settings.axis_steps_per_mm[E_AXIS_N(extruder)] != settings.axis_steps_per_mm[E_AXIS_N(last_extruder)]) {
+      #if ENABLED(SEGMENT_COALESCING)
+        flush_coalesced(); // Queue the held moves in the old E units
+      #endif
       position.e = LROUND(position.e * settings.axis_steps_per_mm[E_AXIS_N(extruder)] * steps_to_mm[E_AXIS_N(last_extruder)]);
       last_extruder = extruder;
     }
@@ -2541,6 +2852,10 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
     const xyze_pos_t target_float = { a, b, c, e };
   #endif
 
+  #if ENABLED(SEGMENT_COALESCING)
+    if (coalesce_segment(target, target_float, fr_mm_s, extruder, millimeters)) return true;
+  #endif
+
   // DRYRUN prevents E moves from taking place
   if (DEBUGGING(DRYRUN)
     #if ENABLED(CANCEL_OBJECTS)
@@ -2670,6 +2985,9 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
  */
 
 void Planner::set_machine_position_mm(const float &a, const float &b, const float &c, const float &e) {
+  #if ENABLED(SEGMENT_COALESCING)
+    flush_coalesced();
+  #endif
   #if ENABLED(DISTINCT_E_FACTORS)
     last_extruder = active_extruder;
   #endif
@@ -2713,6 +3031,9 @@ void Planner::set_position_mm(const float &rx, const float &ry, const float &rz,
  * Setters for planner position (also setting stepper position).
  */
 void Planner::set_e_position_mm(const float &e) {
+  #if ENABLED(SEGMENT_COALESCING)
+    flush_coalesced();
+  #endif
   const uint8_t axis_index = E_AXIS_N(active_extruder);
   #if ENABLED(DISTINCT_E_FACTORS)
     last_extruder = active_extruder;
@@ -55,6 +55,10 @@
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(BUFFER_MONITORING)
+  #include "../feature/buffer_monitor.h"
+#endif
+
 // Feedrate for manual moves
 #ifdef MANUAL_FEEDRATE
   constexpr xyze_feedrate_t manual_feedrate_mm_m = MANUAL_FEEDRATE;
@@ -91,11 +95,27 @@ enum BlockFlag : char {
  *
  * The "nominal" values are as-specified by gcode, and
  * may never actually be reached due to acceleration limits.
+ *
+ * Only the data used by the look-ahead and the Stepper ISR lives here,
+ * with the small fields packed together. Per-block data used once per
+ * block is kept apart in block_aux_t.
  */
 typedef struct block_t {
 
   volatile uint8_t flag;                    // Block flags (See BlockFlag enum above) - Modified by ISR and main thread!
 
+  uint8_t direction_bits;                   // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
+
+  #if EXTRUDERS > 1
+    uint8_t extruder;                       // The extruder to move (if E move)
+  #else
+    static constexpr uint8_t extruder = 0;
+  #endif
+
+  #if ENABLED(LIN_ADVANCE)
+    bool use_advance_lead;                  // Advance extrusion
+  #endif
+
   // Fields used by the motion planner to manage acceleration
   float nominal_speed_sqr,                  // The nominal speed for this block in (mm/sec)^2
         entry_speed_sqr,                    // Entry speed at previous-current junction in (mm/sec)^2
@@ -109,16 +129,6 @@ typedef struct block_t {
   };
   uint32_t step_event_count;                // The number of step events required to complete this block
 
-  #if EXTRUDERS > 1
-    uint8_t extruder;                       // The extruder to move (if E move)
-  #else
-    static constexpr uint8_t extruder = 0;
-  #endif
-
-  #if ENABLED(MIXING_EXTRUDER)
-    MIXER_BLOCK_FIELD;                      // Normalized color for the mixing steppers
-  #endif
-
   // Settings for the trapezoid generator
   uint32_t accelerate_until,                // The index of the step event on which to stop acceleration
            decelerate_after;                // The index of the step event on which to start decelerating
@@ -129,49 +139,80 @@ typedef struct block_t {
              deceleration_time,
              acceleration_time_inverse,     // Inverse of acceleration and deceleration periods, expressed as integer. Scale depends on CPU being used
              deceleration_time_inverse;
+    #if ENABLED(S_CURVE_JUNCTIONS)
+      uint32_t acceleration_mm;             // acceleration mm/sec^2, rounded, to match against the next block
+    #endif
   #else
     uint32_t acceleration_rate;             // The acceleration rate used for acceleration calculation
   #endif
 
-  uint8_t direction_bits;                   // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
-
   // Advance extrusion
-  #if ENABLED(LIN_ADVANCE)
-    bool use_advance_lead;
+  #if HAS_ADVANCE_ISR
     uint16_t advance_speed,                 // STEP timer value for extruder speed offset ISR
              max_adv_steps,                 // max. advance steps to get cruising speed pressure (not always nominal_speed!)
              final_adv_steps;               // advance steps due to exit speed
+  #elif ENABLED(LA_PRESSURE_SMOOTHING)
+    uint32_t la_coeff;                      // Advance in 2^-24 E steps per step event per second, 0 for none
+  #endif
+  #if ENABLED(LIN_ADVANCE)
     float e_D_ratio;
   #endif
 
+  #if ENABLED(LEVELING_STREAM)
+    float level_scale,                      // Leveling fade times Z steps/mm, or 0 if the stream is off for this block
+          level_start,                      // Leveling offset at the start of the block in Z steps
+          level_delta;                      // Change of the leveling offset to the end of the block in Z steps
+  #endif
+
   uint32_t nominal_rate,                    // The nominal step rate for this block in step_events/sec
            initial_rate,                    // The jerk-adjusted step rate at start of block
            final_rate,                      // The minimal rate at exit
            acceleration_steps_per_s2;       // acceleration steps/sec^2
 
-  #if HAS_CUTTER
-    cutter_power_t cutter_power;            // Power level for Spindle, Laser, etc.
-  #endif
+} block_t;
 
-  #if FAN_COUNT > 0
-    uint8_t fan_speed[FAN_COUNT];
-  #endif
+#define HAS_BLOCK_AUX (ANY(MIXING_EXTRUDER, BARICUDA, POWER_LOSS_RECOVERY) || HAS_CUTTER || FAN_COUNT > 0 || HAS_BUFFER_RUNTIME)
 
-  #if ENABLED(BARICUDA)
-    uint8_t valve_pressure, e_to_p_pressure;
-  #endif
+#if HAS_BLOCK_AUX
 
-  #if HAS_SPI_LCD
-    uint32_t segment_time_us;
-  #endif
+  /**
+   * struct block_aux_t
+   *
+   * Per-block data that is only read when the block starts or reaches the
+   * tail. Stored in Planner::block_aux, in step with Planner::block_buffer.
+   * Zeroed for sync blocks.
+   */
+  typedef struct {
 
-  #if ENABLED(POWER_LOSS_RECOVERY)
-    uint32_t sdpos;
-  #endif
+    #if ENABLED(MIXING_EXTRUDER)
+      MIXER_BLOCK_FIELD;                    // Normalized color for the mixing steppers
+    #endif
 
-} block_t;
+    #if HAS_CUTTER
+      cutter_power_t cutter_power;          // Power level for Spindle, Laser, etc.
+    #endif
 
-#define HAS_POSITION_FLOAT ANY(LIN_ADVANCE, SCARA_FEEDRATE_SCALING, GRADIENT_MIX, LCD_SHOW_E_TOTAL)
+    #if FAN_COUNT > 0
+      uint8_t fan_speed[FAN_COUNT];
+    #endif
+
+    #if ENABLED(BARICUDA)
+      uint8_t valve_pressure, e_to_p_pressure;
+    #endif
+
+    #if HAS_BUFFER_RUNTIME
+      uint32_t segment_time_us;
+    #endif
+
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      uint32_t sdpos;
+    #endif
+
+  } block_aux_t;
+
+#endif
+
+#define HAS_POSITION_FLOAT ANY(LIN_ADVANCE, SCARA_FEEDRATE_SCALING, GRADIENT_MIX, LCD_SHOW_E_TOTAL, SEGMENT_COALESCING)
 
 #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
 
@@ -187,6 +228,44 @@ typedef struct {
             min_travel_feedrate_mm_s;           // (mm/s) M205 T - Minimum travel feedrate
 } planner_settings_t;
 
+#if ENABLED(PLANNER_STATS)
+  // Look-ahead work counters, for benchmarks
+  typedef struct {
+    uint32_t recalcs,                           // Calls to recalculate()
+             reverse_visits,                    // Blocks visited by reverse_pass()
+             forward_visits,                    // Blocks visited by forward_pass()
+             trapezoid_visits,                  // Blocks visited by recalculate_trapezoids()
+             trapezoids;                        // Trapezoids (re)calculated
+    uint8_t reverse_max,                        // Most blocks visited by a single pass
+            forward_max,
+            trapezoid_max;
+  } planner_stats_t;
+#endif
+
+#if ENABLED(SEGMENT_COALESCING)
+  #define HAS_COALESCE_AUX (HAS_CUTTER || FAN_COUNT > 0 || ENABLED(POWER_LOSS_RECOVERY))
+
+  // A run of short collinear moves held back to be queued as one block
+  typedef struct {
+    uint8_t count,                              // Moves in the run, 0 if none is held
+            extruder;
+    feedRate_t fr_mm_s;
+    float e_per_mm;                             // E/mm ratio of the first move
+    abce_long_t target;                         // Step target of the last move
+    xyze_pos_t target_float;                    // Machine target of the last move
+    xyz_pos_t point[SEGMENT_COALESCE_MAX_MOVES - 1]; // Dropped ends of the earlier moves
+    #if HAS_CUTTER
+      cutter_power_t cutter_power;              // Block side data as of the first move
+    #endif
+    #if FAN_COUNT > 0
+      uint8_t fan_speed[FAN_COUNT];
+    #endif
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      uint32_t sdpos;
+    #endif
+  } coalesce_t;
+#endif
+
 #if DISABLED(SKEW_CORRECTION)
   #define XY_SKEW_FACTOR 0
   #define XZ_SKEW_FACTOR 0
@@ -224,6 +303,9 @@ class Planner {
      *  Reader of tail is Stepper::isr(). Always consider tail busy / read-only
      */
     static block_t block_buffer[BLOCK_BUFFER_SIZE];
+    #if HAS_BLOCK_AUX
+      static block_aux_t block_aux[BLOCK_BUFFER_SIZE]; // Side data of each block in block_buffer
+    #endif
     static volatile uint8_t block_buffer_head,      // Index of the next block to be pushed
                             block_buffer_nonbusy,   // Index of the first non busy block
                             block_buffer_planned,   // Index of the optimally planned block
@@ -255,6 +337,9 @@ class Planner {
 
     #if DISABLED(CLASSIC_JERK)
       static float junction_deviation_mm;       // (mm) M205 J
+      #if ENABLED(ARC_JUNCTION_SPEED)
+        static float arc_radius;                // (mm) Radius of the arc being planned, for the junctions within it. 0 otherwise.
+      #endif
       #if ENABLED(LIN_ADVANCE)
         static float max_e_jerk                 // Calculated from junction_deviation_mm
           #if ENABLED(DISTINCT_E_FACTORS)
@@ -298,12 +383,21 @@ class Planner {
 
     static skew_factor_t skew_factor;
 
+    #if ENABLED(PLANNER_STATS)
+      static planner_stats_t stats;
+      FORCE_INLINE static void reset_stats() { stats = {}; }
+    #endif
+
     #if ENABLED(SD_ABORT_ON_ENDSTOP_HIT)
       static bool abort_on_endstop_hit;
     #endif
 
   private:
 
+    #if ENABLED(SEGMENT_COALESCING)
+      static coalesce_t coalesced;
+    #endif
+
     /**
      * The current position of the tool in absolute steps
      * Recalculated if any axis_steps_per_mm are changed by gcode
@@ -333,7 +427,7 @@ class Planner {
       /**
        * Counters to manage disabling inactive extruders
        */
-      static uint8_t g_uc_extruder_last_move[EXTRUDERS];
+      static uint16_t g_uc_extruder_last_move[EXTRUDERS];
     #endif // DISABLE_INACTIVE_EXTRUDER
 
     #ifdef XY_FREQUENCY_LIMIT
@@ -345,7 +439,7 @@ class Planner {
       static xy_ulong_t axis_segment_time_us[3];
     #endif
 
-    #if HAS_SPI_LCD
+    #if HAS_BUFFER_RUNTIME
       volatile static uint32_t block_buffer_runtime_us; //Theoretical block buffer runtime in µs
     #endif
 
@@ -551,6 +645,11 @@ class Planner {
     // Check if movement queue is full
     FORCE_INLINE static bool is_full() { return block_buffer_tail == next_block_index(block_buffer_head); }
 
+    #if HAS_BLOCK_AUX
+      // The side data of a block in the buffer
+      FORCE_INLINE static block_aux_t& aux(const block_t * const block) { return block_aux[block - block_buffer]; }
+    #endif
+
     // Get count of movement slots free
     FORCE_INLINE static uint8_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - movesplanned(); }
 
@@ -622,6 +721,24 @@ class Planner {
      */
     static void buffer_sync_block();
 
+    #if ENABLED(SEGMENT_COALESCING)
+      /**
+       * Planner::coalesce_segment
+       * Merge a short move into the held run, or start a new run with it.
+       * Returns true if the move was taken, false to queue it right away.
+       */
+      static bool coalesce_segment(const abce_long_t &target, const xyze_pos_t &target_float,
+        const feedRate_t &fr_mm_s, const uint8_t extruder, const float &millimeters);
+
+      // Queue the held run, if any, as one block
+      static void flush_coalesced();
+
+      // Queue the held run before the Stepper ISR runs short of blocks
+      FORCE_INLINE static void coalesce_idle() {
+        if (coalesced.count && movesplanned() < SEGMENT_COALESCE_MIN_QUEUED) flush_coalesced();
+      }
+    #endif
+
   #if IS_KINEMATIC
     private:
 
@@ -789,8 +906,8 @@ class Planner {
         // No trapezoid calculated? Don't execute yet.
         if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
 
-        #if HAS_SPI_LCD
-          block_buffer_runtime_us -= block->segment_time_us; // We can't be sure how long an active block will take, so don't count it.
+        #if HAS_BUFFER_RUNTIME
+          block_buffer_runtime_us -= aux(block).segment_time_us; // We can't be sure how long an active block will take, so don't count it.
         #endif
 
         // As this block is busy, advance the nonbusy block pointer
@@ -805,10 +922,14 @@ class Planner {
       }
 
       // The queue became empty
-      #if HAS_SPI_LCD
+      #if HAS_BUFFER_RUNTIME
         clear_block_buffer_runtime(); // paranoia. Buffer is empty now - so reset accumulated time to zero.
       #endif
 
+      #if ENABLED(BUFFER_MONITORING)
+        buffer_monitor.ran_dry();
+      #endif
+
       return nullptr;
     }
 
@@ -822,7 +943,20 @@ class Planner {
         block_buffer_tail = next_block_index(block_buffer_tail);
     }
 
-    #if HAS_SPI_LCD
+    #if ENABLED(S_CURVE_JUNCTIONS)
+      /**
+       * The block after the busy one, if its trapezoid is ready.
+       * nullptr if there is none, or it's being recalculated or a sync block.
+       * WARNING: Called from Stepper ISR context!
+       */
+      static block_t* get_next_block() {
+        if (movesplanned() < 2) return nullptr;
+        block_t * const block = &block_buffer[next_block_index(block_buffer_tail)];
+        return (block->flag & (BLOCK_FLAG_RECALCULATE | BLOCK_FLAG_SYNC_POSITION)) ? nullptr : block;
+      }
+    #endif
+
+    #if HAS_BUFFER_RUNTIME
 
       static uint16_t block_buffer_runtime() {
         #ifdef __AVR__
@@ -935,13 +1069,13 @@ class Planner {
 
     static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
 
-    static void reverse_pass_kernel(block_t* const current, const block_t * const next);
+    static bool reverse_pass_kernel(block_t* const current, const block_t * const next);
     static void forward_pass_kernel(const block_t * const previous, block_t* const current, uint8_t block_index);
 
-    static void reverse_pass();
-    static void forward_pass();
+    static uint8_t reverse_pass();
+    static void forward_pass(const uint8_t start);
 
-    static void recalculate_trapezoids();
+    static void recalculate_trapezoids(const uint8_t start);
 
     static void recalculate();
 
@@ -89,6 +89,10 @@ Stepper stepper; // Singleton
   #include "speed_lookuptable.h"
 #endif
 
+#if ENABLED(S_CURVE_LOOKUP_TABLE)
+  #include "bezier_lookuptable.h"
+#endif
+
 #include "endstops.h"
 #include "planner.h"
 #include "motion.h"
@@ -127,6 +131,16 @@ Stepper stepper; // Singleton
   #include "../feature/power_loss_recovery.h"
 #endif
 
+#if ENABLED(LEVELING_STREAM)
+  #include "../feature/bedlevel/bedlevel.h"
+#endif
+
+#if ENABLED(STEPPER_ISR_PROFILE)
+  #include "../feature/isr_profile.h"
+#else
+  #define ISR_PROFILE_PHASE(P, CODE) CODE
+#endif
+
 // public:
 
 #if HAS_EXTRA_ENDSTOPS || ENABLED(Z_STEPPER_AUTO_ALIGN)
@@ -192,20 +206,29 @@ uint32_t Stepper::advance_divisor = 0,
 #endif
 
 #if ENABLED(S_CURVE_ACCELERATION)
-  int32_t __attribute__((used)) Stepper::bezier_A __asm__("bezier_A");    // A coefficient in Bézier speed curve with alias for assembler
-  int32_t __attribute__((used)) Stepper::bezier_B __asm__("bezier_B");    // B coefficient in Bézier speed curve with alias for assembler
-  int32_t __attribute__((used)) Stepper::bezier_C __asm__("bezier_C");    // C coefficient in Bézier speed curve with alias for assembler
+  #if ENABLED(S_CURVE_LOOKUP_TABLE)
+    int32_t Stepper::bezier_dv;       // Speed change over the Bézier speed curve
+  #else
+    int32_t __attribute__((used)) Stepper::bezier_A __asm__("bezier_A");  // A coefficient in Bézier speed curve with alias for assembler
+    int32_t __attribute__((used)) Stepper::bezier_B __asm__("bezier_B");  // B coefficient in Bézier speed curve with alias for assembler
+    int32_t __attribute__((used)) Stepper::bezier_C __asm__("bezier_C");  // C coefficient in Bézier speed curve with alias for assembler
+  #endif
   uint32_t __attribute__((used)) Stepper::bezier_F __asm__("bezier_F");   // F coefficient in Bézier speed curve with alias for assembler
   uint32_t __attribute__((used)) Stepper::bezier_AV __asm__("bezier_AV"); // AV coefficient in Bézier speed curve with alias for assembler
   #ifdef __AVR__
     bool __attribute__((used)) Stepper::A_negative __asm__("A_negative"); // If A coefficient was negative
   #endif
   bool Stepper::bezier_2nd_half;    // =false If Bézier curve has been initialized or not
+  #if ENABLED(S_CURVE_JUNCTIONS)
+    int32_t Stepper::bezier_J0, Stepper::bezier_J1;
+    uint16_t Stepper::ramp_in, Stepper::ramp_out;
+    int16_t Stepper::junction_carry; // = 0
+  #endif
 #endif
 
 uint32_t Stepper::nextMainISR = 0;
 
-#if ENABLED(LIN_ADVANCE)
+#if HAS_ADVANCE_ISR
 
   constexpr uint32_t LA_ADV_NEVER = 0xFFFFFFFF;
   uint32_t Stepper::nextAdvanceISR = LA_ADV_NEVER,
@@ -218,13 +241,50 @@ uint32_t Stepper::nextMainISR = 0;
 
   bool Stepper::LA_use_advance_lead;
 
+#elif ENABLED(LA_PRESSURE_SMOOTHING)
+
+  uint32_t Stepper::la_coeff;
+  int32_t Stepper::la_advance = 0,
+          Stepper::la_pending = 0;
+  int16_t Stepper::la_advance_steps = 0;
+  uint32_t Stepper::la_interval;
+  int8_t Stepper::la_direction = 0;
+
 #endif // LIN_ADVANCE
 
+#if ENABLED(INPUT_SHAPING)
+
+  constexpr uint32_t SHAPING_NEVER = 0xFFFFFFFF;
+  uint32_t Stepper::nextShapingISR = SHAPING_NEVER,
+           Stepper::shaping_clock;
+  shaper_t Stepper::shaper[2];
+  uint8_t Stepper::shaping_direction_bits;
+  shaping_train_t Stepper::shaping_next[2];
+  uint8_t Stepper::shaping_next_bits; // = 0
+  shaper_settings_t Stepper::shaper_settings[2];
+
+#endif
+
+#if ENABLED(LEVELING_STREAM)
+
+  constexpr uint32_t LEVELING_INTERVAL = (STEPPER_TIMER_RATE) / (LEVELING_STREAM_RATE);
+  uint32_t Stepper::nextLevelingISR = 0;
+  int16_t Stepper::leveling_steps = 0;
+
+#endif
+
 int32_t Stepper::ticks_nominal = -1;
 #if DISABLED(S_CURVE_ACCELERATION)
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
 #endif
 
+#if ENABLED(STEP_SCHEDULE)
+  step_schedule_t Stepper::schedule[STEP_SCHEDULE_SLOTS];
+  const step_segment_t *Stepper::schedule_segment, // = nullptr
+                       *Stepper::schedule_end;
+  uint16_t Stepper::schedule_isrs_left;
+#endif
+
 xyz_long_t Stepper::endstops_trigsteps;
 xyze_long_t Stepper::count_position{0};
 xyze_int8_t Stepper::count_direction{0};
@@ -437,19 +497,34 @@ void Stepper::set_directions() {
       count_direction[_AXIS(A)] = 1;            \
     }
 
+  #if ENABLED(INPUT_SHAPING)
+    // A shaped axis keeps the DIR pin of its latest output step
+    #define SET_SHAPED_STEP_DIR(A)                                          \
+      if (shaper[_AXIS(A)].echoes) {                                        \
+        A##_APPLY_DIR(TEST(shaping_direction_bits, _AXIS(A)) ? INVERT_##A##_DIR : !INVERT_##A##_DIR, false); \
+        count_direction[_AXIS(A)] = motor_direction(_AXIS(A)) ? -1 : 1;     \
+      }                                                                     \
+      else { SET_STEP_DIR(A); }
+  #else
+    #define SET_SHAPED_STEP_DIR SET_STEP_DIR
+  #endif
+
   #if HAS_X_DIR
-    SET_STEP_DIR(X); // A
+    SET_SHAPED_STEP_DIR(X); // A
   #endif
 
   #if HAS_Y_DIR
-    SET_STEP_DIR(Y); // B
+    SET_SHAPED_STEP_DIR(Y); // B
   #endif
 
   #if HAS_Z_DIR
     SET_STEP_DIR(Z); // C
   #endif
 
-  #if DISABLED(LIN_ADVANCE)
+  #if ENABLED(LA_PRESSURE_SMOOTHING)
+    // The pulse phase sets the E DIR of each step
+    count_direction.e = motor_direction(E_AXIS) ? -1 : 1;
+  #elif DISABLED(LIN_ADVANCE)
     #if ENABLED(MIXING_EXTRUDER)
        // Because this is valid for the whole block we don't know
        // what e-steppers will step. Likely all. Set all.
@@ -1225,6 +1300,36 @@ void Stepper::set_directions() {
       return (r2 | (uint16_t(r3) << 8)) | (uint32_t(r4) << 16);
     }
 
+  #elif ENABLED(S_CURVE_LOOKUP_TABLE)
+
+    /**
+     * Table-assisted evaluation for 32-bit CPUs
+     *
+     * The curve is v(t) = v0 + (v1 - v0) * s(t), where s(t) = 10t^3 - 15t^4 + 6t^5
+     * is the same for every ramp. s(t) is read from a table of 257 points in Q16
+     * and linearly interpolated, so a point costs one 32x32 multiply for t, one
+     * 16x16 multiply for the interpolation and one 32x32->64 multiply for the
+     * speed change. The speed error is within 8 steps/s of the polynomial.
+     * buildroot/share/scripts/createBezierLookupTable.py --check compares both.
+     */
+    FORCE_INLINE static int32_t bezier_table_eval(const uint32_t v0, const int32_t dv, const uint32_t t) {
+      const uint32_t i = t >> (32 - BEZIER_TABLE_BITS),
+                     frac = (t >> (16 - BEZIER_TABLE_BITS)) & 0xFFFF,
+                     s0 = bezier_lookuptable[i],
+                     s = s0 + (((bezier_lookuptable[i + 1] - s0) * frac) >> 16);
+      return int32_t(v0) + int32_t((int64_t(dv) * s + 0x8000) >> 16);
+    }
+
+    FORCE_INLINE void Stepper::_calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av) {
+      bezier_F = v0;
+      bezier_dv = v1 - v0;
+      bezier_AV = av;
+    }
+
+    FORCE_INLINE int32_t Stepper::_eval_bezier_curve(const uint32_t curr_step) {
+      return bezier_table_eval(bezier_F, bezier_dv, bezier_AV * curr_step);
+    }
+
   #else
 
     // For all the other 32bit CPUs
@@ -1303,6 +1408,82 @@ void Stepper::set_directions() {
       #endif
     }
   #endif
+
+  #if ENABLED(S_CURVE_JUNCTIONS)
+
+    /**
+     * Carry the acceleration through the junction of two ramps
+     *
+     * Over the normalized ramp time u the speed curve from v0 to v1 becomes
+     *
+     *   v(u) = v0 + (v1 - v0) * s(u) + J0 * p(u) + J1 * q(u)
+     *
+     *   s(u) = 10u^3 - 15u^4 + 6u^5         (the plain Bézier curve)
+     *   p(u) = u - 3u^2 + 5u^4 - 3u^5       (slope 1 at the start)
+     *   q(u) = 3u^2 - 10u^3 + 10u^4 - 3u^5  (slope 1 at the end)
+     *
+     * p and q are zero at both ends, flat at the other end and have no area,
+     * so the ramp keeps its speeds, time and distance. J = v1 - v0 would be
+     * the full block acceleration, so J = (v1 - v0) * r keeps r of it.
+     */
+    void Stepper::_calc_bezier_junction(const int32_t dv, const uint16_t r0, const uint16_t r1) {
+      bezier_J0 = (int64_t(dv) * r0) >> 14;
+      bezier_J1 = (int64_t(dv) * r1) >> 14;
+    }
+
+    FORCE_INLINE int32_t Stepper::_eval_bezier_junction(const uint32_t curr_step) {
+      if (!(bezier_J0 | bezier_J1)) return 0;
+      const uint32_t u = (bezier_AV * curr_step) >> 16,     // Q16, like t in _eval_bezier_curve
+                     u2 = (u * u) >> 16, u3 = (u2 * u) >> 16,
+                     u4 = (u3 * u) >> 16, u5 = (u4 * u) >> 16;
+      const int32_t p = int32_t(u + 5 * u4) - int32_t(3 * (u2 + u5)),
+                    q = int32_t(3 * u2 + 10 * u4) - int32_t(10 * u3 + 3 * u5);
+      return int32_t((int64_t(bezier_J0) * p + int64_t(bezier_J1) * q) >> 16);
+    }
+
+    /**
+     * Set the acceleration kept at both ends of the new current block.
+     * The start takes what the last block handed over, if this block still
+     * starts the same way. The end hands over to the next block if it's
+     * ready and carries on accelerating (or braking). Both sides meet at
+     * the lower of the two accelerations.
+     */
+    void Stepper::plan_junction_ramps() {
+      const block_t * const block = current_block;
+      const bool starts_up = block->accelerate_until && block->cruise_rate > block->initial_rate,
+                 starts_down = !block->decelerate_after && block->cruise_rate > block->final_rate,
+                 ends_up = block->accelerate_until >= block->step_event_count && block->cruise_rate > block->initial_rate,
+                 ends_down = block->decelerate_after < block->step_event_count && block->cruise_rate > block->final_rate;
+
+      ramp_in = junction_carry > 0 ? (starts_up ? junction_carry : 0) : (starts_down ? -junction_carry : 0);
+      ramp_out = 0;
+      junction_carry = 0;
+
+      if (!ends_up && !ends_down) return;
+
+      const block_t * const next = planner.get_next_block();
+      if (!next) return;
+
+      #if ENABLED(STEP_SCHEDULE)
+        // A compiled pulse train has the plain ramps
+        const uint8_t next_index = next - planner.block_buffer;
+        const step_schedule_t &sched = schedule_slot(next_index);
+        if (sched.state == SCHEDULE_READY && sched.block_index == next_index) return;
+      #endif
+
+      if (ends_up
+        ? next->accelerate_until && next->cruise_rate > next->initial_rate
+        : !next->decelerate_after && next->cruise_rate > next->final_rate
+      ) {
+        const uint32_t a = block->acceleration_mm, an = next->acceleration_mm;
+        ramp_out = an < a ? (an << 14) / a : _BV(14);
+        const int16_t r = an > a ? (a << 14) / an : _BV(14);
+        junction_carry = ends_up ? r : -r;
+      }
+    }
+
+  #endif // S_CURVE_JUNCTIONS
+
 #endif // S_CURVE_ACCELERATION
 
 /**
@@ -1337,6 +1518,10 @@ void Stepper::isr() {
   // periods to big periods are respected and the timer does not reset to 0
   HAL_timer_set_compare(STEP_TIMER_NUM, hal_timer_t(HAL_TIMER_TYPE_MAX));
 
+  #if ENABLED(STEPPER_ISR_PROFILE)
+    const uint32_t isr_start = HAL_cycle_count();
+  #endif
+
   // Count of ticks for the next ISR
   hal_timer_t next_isr_ticks = 0;
 
@@ -1350,37 +1535,66 @@ void Stepper::isr() {
     ENABLE_ISRS();
 
     // Run main stepping pulse phase ISR if we have to
-    if (!nextMainISR) Stepper::stepper_pulse_phase_isr();
+    if (!nextMainISR) ISR_PROFILE_PHASE(ISR_PHASE_PULSE, Stepper::stepper_pulse_phase_isr());
 
-    #if ENABLED(LIN_ADVANCE)
+    #if HAS_ADVANCE_ISR
       // Run linear advance stepper ISR if we have to
-      if (!nextAdvanceISR) nextAdvanceISR = Stepper::advance_isr();
+      if (!nextAdvanceISR) ISR_PROFILE_PHASE(ISR_PHASE_ADVANCE, nextAdvanceISR = Stepper::advance_isr());
+    #endif
+
+    #if ENABLED(INPUT_SHAPING)
+      // Run the input shaper echoes if we have to
+      if (!nextShapingISR) ISR_PROFILE_PHASE(ISR_PHASE_SHAPING, nextShapingISR = Stepper::shaping_isr());
+    #endif
+
+    #if ENABLED(LEVELING_STREAM)
+      // Follow the leveling mesh if we have to
+      if (!nextLevelingISR) ISR_PROFILE_PHASE(ISR_PHASE_LEVELING, nextLevelingISR = Stepper::leveling_isr());
     #endif
 
     // ^== Time critical. NOTHING besides pulse generation should be above here!!!
 
     // Run main stepping block processing ISR if we have to
-    if (!nextMainISR) nextMainISR = Stepper::stepper_block_phase_isr();
+    if (!nextMainISR) ISR_PROFILE_PHASE(ISR_PHASE_BLOCK, nextMainISR = Stepper::stepper_block_phase_isr());
 
     uint32_t interval =
-      #if ENABLED(LIN_ADVANCE)
+      #if HAS_ADVANCE_ISR
         _MIN(nextAdvanceISR, nextMainISR)  // Nearest time interval
       #else
         nextMainISR                       // Remaining stepper ISR time
       #endif
     ;
 
+    #if ENABLED(INPUT_SHAPING)
+      NOMORE(interval, nextShapingISR);
+    #endif
+
+    #if ENABLED(LEVELING_STREAM)
+      NOMORE(interval, nextLevelingISR);
+    #endif
+
     // Limit the value to the maximum possible value of the timer
     NOMORE(interval, uint32_t(HAL_TIMER_TYPE_MAX));
 
     // Compute the time remaining for the main isr
     nextMainISR -= interval;
 
-    #if ENABLED(LIN_ADVANCE)
+    #if HAS_ADVANCE_ISR
       // Compute the time remaining for the advance isr
       if (nextAdvanceISR != LA_ADV_NEVER) nextAdvanceISR -= interval;
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      // Compute the time remaining for the next echo, and keep the clock of the input steps
+      if (nextShapingISR != SHAPING_NEVER) nextShapingISR -= interval;
+      shaping_clock += interval;
+    #endif
+
+    #if ENABLED(LEVELING_STREAM)
+      // Compute the time remaining for the next mesh lookup
+      nextLevelingISR -= interval;
+    #endif
+
     /**
      * This needs to avoid a race-condition caused by interleaving
      * of interrupts required by both the LA and Stepper algorithms.
@@ -1438,7 +1652,12 @@ void Stepper::isr() {
      * loop to 10 iterations. Beyond that, there's no way to ensure correct pulse
      * timing, since the MCU isn't fast enough.
      */
-    if (!--max_loops) next_isr_ticks = min_ticks;
+    if (!--max_loops) {
+      next_isr_ticks = min_ticks;
+      #if ENABLED(STEPPER_ISR_PROFILE)
+        isr_profile.saturations++;
+      #endif
+    }
 
     // Advance pulses if not enough time to wait for the next ISR
   } while (next_isr_ticks < min_ticks);
@@ -1449,6 +1668,11 @@ void Stepper::isr() {
   // Set the next ISR to fire at the proper time
   HAL_timer_set_compare(STEP_TIMER_NUM, hal_timer_t(next_isr_ticks));
 
+  #if ENABLED(STEPPER_ISR_PROFILE)
+    isr_profile.catch_ups += 9 - max_loops; // Passes after the first
+    isr_profile.record(ISR_PHASE_TOTAL, HAL_cycle_count() - isr_start);
+  #endif
+
   // Don't forget to finally reenable interrupts
   ENABLE_ISRS();
 }
@@ -1473,11 +1697,31 @@ void Stepper::stepper_pulse_phase_isr() {
       current_block = nullptr;
       planner.discard_current_block();
     }
+    #if ENABLED(INPUT_SHAPING)
+      shaping_abort();
+    #endif
+    #if ENABLED(LEVELING_STREAM)
+      leveling_steps = 0; // The steps taken are in count_position
+    #endif
+    #if ENABLED(LA_PRESSURE_SMOOTHING)
+      la_advance = la_pending = la_advance_steps = 0;
+    #endif
+    #if ENABLED(S_CURVE_JUNCTIONS)
+      junction_carry = 0;
+    #endif
   }
 
   // If there is no current block, do nothing
   if (!current_block) return;
 
+  #if ENABLED(LA_PRESSURE_SMOOTHING)
+    // An E-only block held by the block phase until its E steps are out
+    if (step_events_completed >= step_event_count) {
+      if (la_pending) pressure_step();
+      return;
+    }
+  #endif
+
   // Count of pending loops and events for this iteration
   const uint32_t pending_events = step_event_count - step_events_completed;
   uint8_t events_to_do = _MIN(pending_events, steps_per_isr);
@@ -1520,18 +1764,42 @@ void Stepper::stepper_pulse_phase_isr() {
       } \
     }while(0)
 
+    #if ENABLED(INPUT_SHAPING)
+      // Pass the steps of a shaped axis through the shaper, which may output a step now
+      #define PULSE_PREP_SHAPED(AXIS) do{ \
+        PULSE_PREP(AXIS); \
+        if (step_needed[_AXIS(AXIS)] && shaper[_AXIS(AXIS)].echoes) \
+          step_needed[_AXIS(AXIS)] = shaping_input(_AXIS(AXIS)); \
+      }while(0)
+    #else
+      #define PULSE_PREP_SHAPED PULSE_PREP
+    #endif
+
     // Determine if pulses are needed
     #if HAS_X_STEP
-      PULSE_PREP(X);
+      PULSE_PREP_SHAPED(X);
     #endif
     #if HAS_Y_STEP
-      PULSE_PREP(Y);
+      PULSE_PREP_SHAPED(Y);
     #endif
     #if HAS_Z_STEP
       PULSE_PREP(Z);
     #endif
 
-    #if EITHER(LIN_ADVANCE, MIXING_EXTRUDER)
+    #if ENABLED(LA_PRESSURE_SMOOTHING)
+      // Step E for Bresenham and for changes of the advance, one step at a time
+      delta_error.e += advance_dividend.e;
+      if (delta_error.e >= 0) {
+        delta_error.e -= advance_divisor;
+        count_position.e += count_direction.e;
+        la_pending += count_direction.e;
+      }
+      step_needed.e = !!la_pending;
+      if (step_needed.e) {
+        pressure_direction(la_pending < 0 ? -1 : 1);
+        la_pending -= la_direction;
+      }
+    #elif EITHER(LIN_ADVANCE, MIXING_EXTRUDER)
       delta_error.e += advance_dividend.e;
       if (delta_error.e >= 0) {
         count_position.e += count_direction.e;
@@ -1565,7 +1833,7 @@ void Stepper::stepper_pulse_phase_isr() {
       PULSE_START(Z);
     #endif
 
-    #if DISABLED(LIN_ADVANCE)
+    #if !HAS_ADVANCE_ISR
       #if ENABLED(MIXING_EXTRUDER)
         if (step_needed.e) E_STEP_WRITE(mixer.get_next_stepper(), !INVERT_E_STEP_PIN);
       #elif HAS_E0_STEP
@@ -1594,7 +1862,7 @@ void Stepper::stepper_pulse_phase_isr() {
       PULSE_STOP(Z);
     #endif
 
-    #if DISABLED(LIN_ADVANCE)
+    #if !HAS_ADVANCE_ISR
       #if ENABLED(MIXING_EXTRUDER)
 
         if (delta_error.e >= 0) {
@@ -1630,6 +1898,15 @@ uint32_t Stepper::stepper_block_phase_isr() {
   // If there is a current block
   if (current_block) {
 
+    #if ENABLED(LA_PRESSURE_SMOOTHING)
+      // E takes one step per step event at most, so an E-only move (like a
+      // retract) can end with steps still owed. Hold it at its last rate
+      // until they're out, so they don't go out with the next moves.
+      if (step_events_completed >= step_event_count && la_pending
+        && !current_block->steps.x && !current_block->steps.y && !current_block->steps.z
+      ) interval = la_interval;
+      else
+    #endif
     // If current block is finished, reset pointer
     if (step_events_completed >= step_event_count) {
       #ifdef FILAMENT_RUNOUT_DISTANCE_MM
@@ -1645,24 +1922,34 @@ uint32_t Stepper::stepper_block_phase_isr() {
       // Are we in acceleration phase ?
       if (step_events_completed <= accelerate_until) { // Calculate new timer value
 
-        #if ENABLED(S_CURVE_ACCELERATION)
-          // Get the next speed to use (Jerk limited!)
-          uint32_t acc_step_rate =
-            acceleration_time < current_block->acceleration_time
-              ? _eval_bezier_curve(acceleration_time)
-              : current_block->cruise_rate;
-        #else
-          acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
-          NOMORE(acc_step_rate, current_block->nominal_rate);
+        #if ENABLED(STEP_SCHEDULE)
+          if (schedule_segment)
+            interval = schedule_next_interval();
+          else
         #endif
+        {
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // Get the next speed to use (Jerk limited!)
+            uint32_t acc_step_rate =
+              acceleration_time < current_block->acceleration_time
+                ? _eval_bezier_curve(acceleration_time)
+                  #if ENABLED(S_CURVE_JUNCTIONS)
+                    + _eval_bezier_junction(acceleration_time)
+                  #endif
+                : current_block->cruise_rate;
+          #else
+            acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
+            NOMORE(acc_step_rate, current_block->nominal_rate);
+          #endif
 
-        // acc_step_rate is in steps/second
+          // acc_step_rate is in steps/second
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(acc_step_rate, oversampling_factor, &steps_per_isr);
-        acceleration_time += interval;
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(acc_step_rate, oversampling_factor, &steps_per_isr);
+          acceleration_time += interval;
+        }
 
-        #if ENABLED(LIN_ADVANCE)
+        #if HAS_ADVANCE_ISR
           if (LA_use_advance_lead) {
             // Fire ISR if final adv_rate is reached
             if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
@@ -1672,42 +1959,56 @@ uint32_t Stepper::stepper_block_phase_isr() {
       }
       // Are we in Deceleration phase ?
       else if (step_events_completed > decelerate_after) {
-        uint32_t step_rate;
 
-        #if ENABLED(S_CURVE_ACCELERATION)
-          // If this is the 1st time we process the 2nd half of the trapezoid...
-          if (!bezier_2nd_half) {
-            // Initialize the Bézier speed curve
-            _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
-            bezier_2nd_half = true;
-            // The first point starts at cruise rate. Just save evaluation of the Bézier curve
-            step_rate = current_block->cruise_rate;
-          }
-          else {
-            // Calculate the next speed to use
-            step_rate = deceleration_time < current_block->deceleration_time
-              ? _eval_bezier_curve(deceleration_time)
-              : current_block->final_rate;
-          }
-        #else
-
-          // Using the old trapezoidal control
-          step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
-          if (step_rate < acc_step_rate) { // Still decelerating?
-            step_rate = acc_step_rate - step_rate;
-            NOLESS(step_rate, current_block->final_rate);
-          }
+        #if ENABLED(STEP_SCHEDULE)
+          if (schedule_segment)
+            interval = schedule_next_interval();
           else
-            step_rate = current_block->final_rate;
         #endif
+        {
+          uint32_t step_rate;
+
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // If this is the 1st time we process the 2nd half of the trapezoid...
+            if (!bezier_2nd_half) {
+              // Initialize the Bézier speed curve
+              _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+              #if ENABLED(S_CURVE_JUNCTIONS)
+                _calc_bezier_junction(current_block->final_rate - current_block->cruise_rate, current_block->decelerate_after ? 0 : ramp_in, ramp_out);
+              #endif
+              bezier_2nd_half = true;
+              // The first point starts at cruise rate. Just save evaluation of the Bézier curve
+              step_rate = current_block->cruise_rate;
+            }
+            else {
+              // Calculate the next speed to use
+              step_rate = deceleration_time < current_block->deceleration_time
+                ? _eval_bezier_curve(deceleration_time)
+                  #if ENABLED(S_CURVE_JUNCTIONS)
+                    + _eval_bezier_junction(deceleration_time)
+                  #endif
+                : current_block->final_rate;
+            }
+          #else
 
-        // step_rate is in steps/second
+            // Using the old trapezoidal control
+            step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
+            if (step_rate < acc_step_rate) { // Still decelerating?
+              step_rate = acc_step_rate - step_rate;
+              NOLESS(step_rate, current_block->final_rate);
+            }
+            else
+              step_rate = current_block->final_rate;
+          #endif
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(step_rate, oversampling_factor, &steps_per_isr);
-        deceleration_time += interval;
+          // step_rate is in steps/second
 
-        #if ENABLED(LIN_ADVANCE)
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(step_rate, oversampling_factor, &steps_per_isr);
+          deceleration_time += interval;
+        }
+
+        #if HAS_ADVANCE_ISR
           if (LA_use_advance_lead) {
             // Wake up eISR on first deceleration loop and fire ISR if final adv_rate is reached
             if (step_events_completed <= decelerate_after + steps_per_isr || (LA_steps && LA_isr_rate != current_block->advance_speed)) {
@@ -1721,19 +2022,26 @@ uint32_t Stepper::stepper_block_phase_isr() {
       // We must be in cruise phase otherwise
       else {
 
-        #if ENABLED(LIN_ADVANCE)
+        #if HAS_ADVANCE_ISR
           // If there are any esteps, fire the next advance_isr "now"
           if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
         #endif
 
-        // Calculate the ticks_nominal for this nominal speed, if not done yet
-        if (ticks_nominal < 0) {
-          // step_rate to timer interval and loops for the nominal speed
-          ticks_nominal = calc_timer_interval(current_block->nominal_rate, oversampling_factor, &steps_per_isr);
-        }
+        #if ENABLED(STEP_SCHEDULE)
+          if (schedule_segment)
+            interval = schedule_next_interval();
+          else
+        #endif
+        {
+          // Calculate the ticks_nominal for this nominal speed, if not done yet
+          if (ticks_nominal < 0) {
+            // step_rate to timer interval and loops for the nominal speed
+            ticks_nominal = calc_timer_interval(current_block->nominal_rate, oversampling_factor, &steps_per_isr);
+          }
 
-        // The timer interval is just the nominal value for the nominal speed
-        interval = ticks_nominal;
+          // The timer interval is just the nominal value for the nominal speed
+          interval = ticks_nominal;
+        }
       }
     }
   }
@@ -1742,6 +2050,13 @@ uint32_t Stepper::stepper_block_phase_isr() {
   // and prepare its movement
   if (!current_block) {
 
+    #if ENABLED(LA_PRESSURE_SMOOTHING) && E_STEPPERS > 1
+      // Let the last extruder have all its steps before another takes over
+      if (pressure_busy() && planner.has_blocks_queued()
+        && planner.block_buffer[planner.block_buffer_tail].extruder != stepper_extruder
+      ) return pressure_release();
+    #endif
+
     // Anything in the buffer?
     if ((current_block = planner.get_current_block())) {
 
@@ -1756,11 +2071,11 @@ uint32_t Stepper::stepper_block_phase_isr() {
       }
 
       #if HAS_CUTTER
-        cutter.apply_power(current_block->cutter_power);
+        cutter.apply_power(planner.aux(current_block).cutter_power);
       #endif
 
       #if ENABLED(POWER_LOSS_RECOVERY)
-        recovery.info.sdpos = current_block->sdpos;
+        recovery.info.sdpos = planner.aux(current_block).sdpos;
       #endif
 
       // Flag all moving axes for proper endstop handling
@@ -1880,17 +2195,27 @@ uint32_t Stepper::stepper_block_phase_isr() {
       #if ENABLED(LIN_ADVANCE)
         #if DISABLED(MIXING_EXTRUDER) && E_STEPPERS > 1
           // If the now active extruder wasn't in use during the last move, its pressure is most likely gone.
-          if (stepper_extruder != last_moved_extruder) LA_current_adv_steps = 0;
+          if (stepper_extruder != last_moved_extruder) {
+            #if HAS_ADVANCE_ISR
+              LA_current_adv_steps = 0;
+            #else
+              la_advance = la_pending = la_advance_steps = la_direction = 0;
+            #endif
+          }
         #endif
 
-        if ((LA_use_advance_lead = current_block->use_advance_lead)) {
-          LA_final_adv_steps = current_block->final_adv_steps;
-          LA_max_adv_steps = current_block->max_adv_steps;
-          //Start the ISR
-          nextAdvanceISR = 0;
-          LA_isr_rate = current_block->advance_speed;
-        }
-        else LA_isr_rate = LA_ADV_NEVER;
+        #if HAS_ADVANCE_ISR
+          if ((LA_use_advance_lead = current_block->use_advance_lead)) {
+            LA_final_adv_steps = current_block->final_adv_steps;
+            LA_max_adv_steps = current_block->max_adv_steps;
+            //Start the ISR
+            nextAdvanceISR = 0;
+            LA_isr_rate = current_block->advance_speed;
+          }
+          else LA_isr_rate = LA_ADV_NEVER;
+        #else
+          la_coeff = current_block->la_coeff;
+        #endif
       #endif
 
       if (
@@ -1938,23 +2263,247 @@ uint32_t Stepper::stepper_block_phase_isr() {
         acc_step_rate = current_block->initial_rate;
       #endif
 
+      #if ENABLED(STEP_SCHEDULE)
+        // Use the pulse train if the main loop has finished compiling it.
+        // The last block may have handed over its acceleration when the
+        // train wasn't ready yet, and the train only has the plain ramps.
+        const uint8_t block_index = current_block - planner.block_buffer;
+        const step_schedule_t &sched = schedule_slot(block_index);
+        if (sched.state == SCHEDULE_READY && sched.block_index == block_index
+          #if ENABLED(S_CURVE_JUNCTIONS)
+            && !junction_carry
+          #endif
+        ) {
+          schedule_segment = sched.segment;
+          schedule_end = sched.segment + sched.count;
+          schedule_isrs_left = schedule_segment->isr_count;
+          interval = schedule_next_interval();
+        }
+        else {
+          schedule_segment = nullptr;
+      #endif
+
       #if ENABLED(S_CURVE_ACCELERATION)
         // Initialize the Bézier speed curve
         _calc_bezier_curve_coeffs(current_block->initial_rate, current_block->cruise_rate, current_block->acceleration_time_inverse);
+        #if ENABLED(S_CURVE_JUNCTIONS)
+          plan_junction_ramps();
+          _calc_bezier_junction(current_block->cruise_rate - current_block->initial_rate, ramp_in,
+            current_block->accelerate_until >= current_block->step_event_count ? ramp_out : 0);
+        #endif
         // We haven't started the 2nd half of the trapezoid
         bezier_2nd_half = false;
       #endif
 
       // Calculate the initial timer interval
       interval = calc_timer_interval(current_block->initial_rate, oversampling_factor, &steps_per_isr);
+
+      #if ENABLED(STEP_SCHEDULE)
+        }
+      #endif
     }
   }
 
+  #if ENABLED(LA_PRESSURE_SMOOTHING)
+    if (current_block)
+      pressure_update(interval);
+    else if (la_pending || la_advance_steps)
+      interval = pressure_release();
+  #endif
+
   // Return the interval to wait
   return interval;
 }
 
-#if ENABLED(LIN_ADVANCE)
+#if ENABLED(STEP_SCHEDULE)
+
+  #if ENABLED(S_CURVE_ACCELERATION)
+
+    // Bézier speed curve of the Stepper ISR, evaluated with the same 32-bit
+    // math (see _eval_bezier_curve) but on private coefficients
+    #if ENABLED(S_CURVE_LOOKUP_TABLE)
+
+      struct schedule_bezier_t {
+        uint32_t f, av;
+        int32_t dv;
+        schedule_bezier_t(const int32_t v0, const int32_t v1, const uint32_t inv) : f(v0), av(inv), dv(v1 - v0) {}
+        int32_t eval(const uint32_t curr_step) const { return bezier_table_eval(f, dv, av * curr_step); }
+      };
+
+    #else
+
+      struct schedule_bezier_t {
+        int32_t a, b, c;
+        uint32_t f, av;
+        schedule_bezier_t(const int32_t v0, const int32_t v1, const uint32_t inv)
+          : a(768 * (v1 - v0)), b(1920 * (v0 - v1)), c(1280 * (v1 - v0)), f(128 * v0), av(inv) {}
+        int32_t eval(const uint32_t curr_step) const {
+          const uint32_t t = av * curr_step;
+          uint64_t p = t;
+          p *= t; p >>= 32;
+          p *= t; p >>= 32;
+          int64_t acc = (int64_t)f << 31;
+          acc += ((uint32_t)p >> 1) * (int64_t)c;
+          p *= t; p >>= 32;
+          acc += ((uint32_t)p >> 1) * (int64_t)b;
+          p *= t; p >>= 32;
+          acc += ((uint32_t)p >> 1) * (int64_t)a;
+          return int32_t(acc >> (31 + 7));
+        }
+      };
+
+    #endif
+
+  #endif
+
+  /**
+   * Run the block phase of the Stepper ISR for a whole block, recording the
+   * interval and steps per ISR of every call as runs of near-equal intervals.
+   * The cruise phase is constant, so it is added in one go.
+   * Return false if the block needs more than STEP_SCHEDULE_SEGMENTS.
+   */
+  bool Stepper::schedule_compile(const block_t * const block, step_schedule_t &sched) {
+
+    uint8_t oversampling = 0;
+    #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+      // Same choice as made by the ISR when the block starts
+      uint32_t max_rate = block->nominal_rate;
+      while (max_rate < MIN_STEP_ISR_FREQUENCY) {
+        max_rate <<= 1;
+        if (max_rate >= MAX_STEP_ISR_FREQUENCY_1X) break;
+        ++oversampling;
+      }
+    #endif
+
+    const uint32_t event_count = block->step_event_count << oversampling,
+                   accel_until = block->accelerate_until << oversampling,
+                   decel_after = block->decelerate_after << oversampling;
+
+    uint8_t count = 0, spi;
+    uint32_t lo = 0, hi = 0;    // Interval range of the open segment
+    uint64_t sum = 0;           // Interval total of the open segment
+
+    // Append 'n' ISRs at 'interval', merging them into the open segment if close enough
+    auto push = [&](const uint32_t interval, const uint32_t n) {
+      step_segment_t *seg = count ? &sched.segment[count - 1] : nullptr;
+      const uint32_t l = _MIN(lo, interval), h = _MAX(hi, interval);
+      if (seg && seg->steps_per_isr == spi && (h - l) * uint32_t(STEP_SCHEDULE_TOLERANCE) <= l && seg->isr_count + n <= 0xFFFF) {
+        lo = l; hi = h;
+        seg->isr_count += n;
+      }
+      else {
+        if (count >= STEP_SCHEDULE_SEGMENTS) return false;
+        seg = &sched.segment[count++];
+        seg->steps_per_isr = spi;
+        seg->isr_count = n;
+        lo = hi = interval;
+        sum = 0;
+      }
+      sum += uint64_t(interval) * n;
+      seg->interval = (sum + seg->isr_count / 2) / seg->isr_count;
+      return true;
+    };
+
+    uint32_t acceleration_time = 0, deceleration_time = 0;
+
+    #if ENABLED(S_CURVE_ACCELERATION)
+      const schedule_bezier_t accel_curve(block->initial_rate, block->cruise_rate, block->acceleration_time_inverse),
+                              decel_curve(block->cruise_rate, block->final_rate, block->deceleration_time_inverse);
+      bool decelerating = false;
+    #else
+      uint32_t acc_step_rate = block->initial_rate;
+    #endif
+
+    // The ISR that starts the block
+    if (!push(calc_timer_interval(block->initial_rate, oversampling, &spi), 1)) return false;
+
+    for (uint32_t completed = 0;;) {
+      // Pulse phase
+      completed += _MIN(event_count - completed, uint32_t(spi));
+      if (completed >= event_count) break;
+
+      // Block phase
+      uint32_t interval;
+      if (completed <= accel_until) {
+        #if ENABLED(S_CURVE_ACCELERATION)
+          const uint32_t acc_step_rate = acceleration_time < block->acceleration_time
+            ? accel_curve.eval(acceleration_time)
+            : block->cruise_rate;
+        #else
+          acc_step_rate = STEP_MULTIPLY(acceleration_time, block->acceleration_rate) + block->initial_rate;
+          NOMORE(acc_step_rate, block->nominal_rate);
+        #endif
+        interval = calc_timer_interval(acc_step_rate, oversampling, &spi);
+        acceleration_time += interval;
+      }
+      else if (completed > decel_after) {
+        uint32_t step_rate;
+        #if ENABLED(S_CURVE_ACCELERATION)
+          if (!decelerating) {
+            decelerating = true;
+            step_rate = block->cruise_rate;
+          }
+          else
+            step_rate = deceleration_time < block->deceleration_time
+              ? decel_curve.eval(deceleration_time)
+              : block->final_rate;
+        #else
+          step_rate = STEP_MULTIPLY(deceleration_time, block->acceleration_rate);
+          if (step_rate < acc_step_rate) {
+            step_rate = acc_step_rate - step_rate;
+            NOLESS(step_rate, block->final_rate);
+          }
+          else
+            step_rate = block->final_rate;
+        #endif
+        interval = calc_timer_interval(step_rate, oversampling, &spi);
+        deceleration_time += interval;
+      }
+      else {
+        // Every cruise ISR up to the deceleration point (or the end) at once
+        interval = calc_timer_interval(block->nominal_rate, oversampling, &spi);
+        const uint32_t isrs = (_MIN(decel_after, event_count - 1) - completed) / spi + 1;
+        for (uint32_t left = isrs; left;) {
+          const uint32_t n = _MIN(left, uint32_t(0xFFFF));
+          if (!push(interval, n)) return false;
+          left -= n;
+        }
+        completed += (isrs - 1) * spi;
+        continue;
+      }
+
+      if (!push(interval, 1)) return false;
+    }
+
+    sched.count = count;
+    return true;
+  }
+
+  /**
+   * Compile the pulse trains of the first planned blocks not yet taken by
+   * the Stepper ISR. Blocks still waiting for the planner are left alone;
+   * recalculating a trapezoid invalidates its pulse train.
+   */
+  void Stepper::schedule_ahead() {
+    uint8_t b = planner.block_buffer_nonbusy;
+    for (uint8_t i = STEP_SCHEDULE_LOOKAHEAD; i-- && b != planner.block_buffer_head; b = BLOCK_MOD(b + 1)) {
+      block_t * const block = &planner.block_buffer[b];
+      step_schedule_t &sched = schedule_slot(b);
+      if ((sched.block_index == b && sched.state != SCHEDULE_EMPTY)
+        || TEST(block->flag, BLOCK_BIT_RECALCULATE)
+        || TEST(block->flag, BLOCK_BIT_SYNC_POSITION)
+      ) continue;
+      // The slot's previous block is done, and the ISR only takes blocks after it
+      sched.state = SCHEDULE_COMPILING;
+      sched.block_index = b;
+      // The ISR may take the block meanwhile, and then it runs without the schedule
+      sched.state = schedule_compile(block, sched) && !is_block_busy(block) ? SCHEDULE_READY : SCHEDULE_EMPTY;
+    }
+  }
+
+#endif // STEP_SCHEDULE
+
+#if HAS_ADVANCE_ISR
 
   // Timer interrupt for E. LA_steps is set in the main routine
   uint32_t Stepper::advance_isr() {
@@ -2051,8 +2600,375 @@ uint32_t Stepper::stepper_block_phase_isr() {
 
     return interval;
   }
+
+#elif ENABLED(LA_PRESSURE_SMOOTHING)
+
+  /**
+   * Move the advance toward K times the E step rate at the current step
+   * event rate, smoothed over LA_SMOOTH_TIME. Whole steps of change are
+   * owed to the extruder, and the pulse phase takes them with the other axes.
+   */
+  void Stepper::pressure_update(const uint32_t interval) {
+    constexpr uint32_t smooth_ticks = (LA_SMOOTH_TIME) * (STEPPER_TIMER_RATE),
+                       smooth_scale = 0xFFFFFFFFUL / smooth_ticks;
+
+    // Step events per second of the block, and the advance they call for
+    const uint32_t rate = (uint32_t(STEPPER_TIMER_RATE) * steps_per_isr / interval) >> oversampling_factor;
+    const int32_t target = (uint64_t(rate) * la_coeff) >> 16;
+
+    // First-order smoothing over the time until the next block phase
+    const uint32_t alpha = (uint64_t(_MIN(interval, smooth_ticks)) * smooth_scale) >> 16;
+    la_advance += (int64_t(target - la_advance) * alpha) >> 16;
+
+    const int16_t steps = (la_advance + 128) >> 8;
+    la_pending += steps - la_advance_steps;
+    la_advance_steps = steps;
+    la_interval = interval;
+  }
+
+  // Set the E DIR for the next advance or Bresenham step
+  void Stepper::pressure_direction(const int8_t dir) {
+    if (dir == la_direction) return;
+    #if MINIMUM_STEPPER_PRE_DIR_DELAY > 0
+      DELAY_NS(MINIMUM_STEPPER_PRE_DIR_DELAY);
+    #endif
+    la_direction = dir;
+    if (dir < 0) REV_E_DIR(stepper_extruder); else NORM_E_DIR(stepper_extruder);
+    #if MINIMUM_STEPPER_POST_DIR_DELAY > 0
+      DELAY_NS(MINIMUM_STEPPER_POST_DIR_DELAY);
+    #endif
+  }
+
+  // Take one owed E step, outside of the pulse phase
+  void Stepper::pressure_step() {
+    pressure_direction(la_pending < 0 ? -1 : 1);
+    E_STEP_WRITE(stepper_extruder, !INVERT_E_STEP_PIN);
+    #if ISR_PULSE_CONTROL
+      hal_timer_t end_tick_count;
+      START_HIGH_PULSE();
+      AWAIT_HIGH_PULSE();
+    #endif
+    E_STEP_WRITE(stepper_extruder, INVERT_E_STEP_PIN);
+    la_pending -= la_direction;
+  }
+
+  /**
+   * With no block there's no pulse phase, so let the advance out
+   * here, one step at a time, as it decays to zero.
+   */
+  uint32_t Stepper::pressure_release() {
+    constexpr uint32_t interval = (STEPPER_TIMER_RATE) / 10000;
+    la_coeff = 0;
+    pressure_update(interval);
+    if (la_pending) pressure_step();
+    return interval;
+  }
+
 #endif // LIN_ADVANCE
 
+#if ENABLED(INPUT_SHAPING)
+
+  #define SHAPING_NEXT(I) ((I) + 1 == SHAPING_BUFFER_SIZE ? 0 : (I) + 1)
+
+  /**
+   * Input Shaping
+   *
+   * The motion of X and Y is convolved with a train of 2 or 3 impulses whose
+   * weights sum to one step. Each input step from the Bresenham line tracer adds
+   * the first weight to the axis accumulator at once, and each later weight when
+   * its echo delay has passed. The motor steps whenever the accumulator passes
+   * half a step, so it lands exactly on the input position after the last echo.
+   */
+
+  // Feed an input step of a shaped axis. Return true if the motor steps now.
+  FORCE_INLINE bool Stepper::shaping_input(const AxisEnum axis) {
+    shaper_t &s = shaper[axis];
+    const bool reverse = count_direction[axis] < 0;
+    const uint16_t next = SHAPING_NEXT(s.head);
+    int16_t weight = SHAPING_UNIT;  // Step unshaped if the buffer is full
+    if (next != s.echo[s.echoes - 1]) {
+      s.step_time[s.head] = (shaping_clock & ~1UL) | reverse;
+      s.head = next;
+      weight = s.weight[0];
+      NOMORE(nextShapingISR, s.delay[0]);
+    }
+    return shaping_output(axis, reverse ? -weight : weight);
+  }
+
+  // Add an impulse to the accumulator. Return true, with the DIR pin set, if the motor steps.
+  FORCE_INLINE bool Stepper::shaping_output(const AxisEnum axis, const int16_t weight) {
+    int16_t &accum = shaper[axis].accum;
+    accum += weight;
+    bool reverse;
+    if (accum >= SHAPING_UNIT / 2) {
+      accum -= SHAPING_UNIT;
+      reverse = false;
+    }
+    else if (accum < -(SHAPING_UNIT / 2)) {
+      accum += SHAPING_UNIT;
+      reverse = true;
+    }
+    else
+      return false;
+
+    if (reverse != TEST(shaping_direction_bits, axis)) shaping_set_direction(axis, reverse);
+    return true;
+  }
+
+  void Stepper::shaping_set_direction(const AxisEnum axis, const bool reverse) {
+    #if MINIMUM_STEPPER_PRE_DIR_DELAY > 0
+      DELAY_NS(MINIMUM_STEPPER_PRE_DIR_DELAY);
+    #endif
+
+    if (axis == X_AXIS)
+      X_APPLY_DIR(reverse ? INVERT_X_DIR : !INVERT_X_DIR, false);
+    else
+      Y_APPLY_DIR(reverse ? INVERT_Y_DIR : !INVERT_Y_DIR, false);
+    SET_BIT_TO(shaping_direction_bits, axis, reverse);
+
+    // A small delay may be needed after changing direction
+    #if MINIMUM_STEPPER_POST_DIR_DELAY > 0
+      DELAY_NS(MINIMUM_STEPPER_POST_DIR_DELAY);
+    #endif
+  }
+
+  // Timer interrupt for the echoes of X and Y. Return the time to the next one.
+  uint32_t Stepper::shaping_isr() {
+    uint32_t interval = SHAPING_NEVER;
+
+    #if ISR_MULTI_STEPS
+      bool firstStep = true;
+      hal_timer_t end_tick_count = 0;
+    #endif
+
+    LOOP_L_N(a, 2) {
+      const AxisEnum axis = AxisEnum(a);
+      shaper_t &s = shaper[axis];
+      LOOP_L_N(e, s.echoes) {
+        const int16_t weight = s.weight[e + 1];
+        for (uint16_t &i = s.echo[e]; i != s.head; i = SHAPING_NEXT(i)) {
+          const uint32_t t = s.step_time[i];
+          const int32_t wait = int32_t((t & ~1UL) + s.delay[e] - shaping_clock);
+          if (wait > 0) { NOMORE(interval, uint32_t(wait)); break; }
+
+          if (!shaping_output(axis, TEST(t, 0) ? -weight : weight)) continue;
+
+          #if ISR_MULTI_STEPS
+            if (firstStep)
+              firstStep = false;
+            else
+              AWAIT_LOW_PULSE();
+          #endif
+
+          // Set the STEP pulse ON
+          if (axis == X_AXIS) X_APPLY_STEP(!INVERT_X_STEP_PIN, 0); else Y_APPLY_STEP(!INVERT_Y_STEP_PIN, 0);
+
+          // Enforce a minimum duration for STEP pulse ON
+          #if ISR_PULSE_CONTROL
+            START_HIGH_PULSE();
+            AWAIT_HIGH_PULSE();
+          #endif
+
+          // Set the STEP pulse OFF
+          if (axis == X_AXIS) X_APPLY_STEP(INVERT_X_STEP_PIN, 0); else Y_APPLY_STEP(INVERT_Y_STEP_PIN, 0);
+
+          #if ISR_PULSE_CONTROL
+            START_LOW_PULSE();
+          #endif
+        }
+      }
+
+      // A new train waits for the last echo (only set on a shaped axis)
+      if (TEST(shaping_next_bits, axis) && s.echo[s.echoes - 1] == s.head) shaping_install(axis);
+    }
+
+    return interval;
+  }
+
+  // Drop the pending echoes and set the step counts to where the motors are
+  void Stepper::shaping_abort() {
+    LOOP_L_N(a, 2) {
+      shaper_t &s = shaper[a];
+      // The weight still to be output is a whole number of steps
+      int32_t pending = s.accum;
+      LOOP_L_N(e, s.echoes) {
+        for (uint16_t i = s.echo[e]; i != s.head; i = SHAPING_NEXT(i))
+          pending += TEST(s.step_time[i], 0) ? -s.weight[e + 1] : s.weight[e + 1];
+        s.echo[e] = s.head;
+      }
+      s.accum = 0;
+      count_position[a] -= pending / (SHAPING_UNIT);
+      if (TEST(shaping_next_bits, a)) shaping_install(AxisEnum(a));
+    }
+    nextShapingISR = SHAPING_NEVER;
+  }
+
+  // Switch an axis with no echoes pending to its train in shaping_next
+  void Stepper::shaping_install(const AxisEnum axis) {
+    shaper_t &s = shaper[axis];
+    const shaping_train_t &t = shaping_next[axis];
+    const bool was_shaped = s.echoes;
+    s.echoes = t.echoes;
+    COPY(s.weight, t.weight);
+    COPY(s.delay, t.delay);
+    LOOP_L_N(e, SHAPING_MAX_ECHOES) s.echo[e] = s.head;
+    CBI(shaping_next_bits, axis);
+
+    // The DIR pin of a shaped axis is the shaper's, otherwise set_directions()'s
+    if (!was_shaped)
+      SET_BIT_TO(shaping_direction_bits, axis, motor_direction(axis));
+    else if (!s.echoes && TEST(shaping_direction_bits, axis) != motor_direction(axis))
+      shaping_set_direction(axis, motor_direction(axis));
+  }
+
+  bool Stepper::input_shaping_busy() {
+    LOOP_L_N(a, 2) {
+      const shaper_t &s = shaper[a];
+      if (s.echoes && s.echo[s.echoes - 1] != s.head) return true;
+    }
+    return false;
+  }
+
+  /**
+   * Compute the impulse trains from shaper_settings. For a damped frequency
+   * period td and K = exp(-zeta * PI / sqrt(1 - zeta^2)):
+   *
+   *   ZV  : 1, K               at 0, td/2
+   *   ZVD : 1, 2K, K^2         at 0, td/2, td
+   *   MZV : a, (√2-1)K', aK'^2 at 0, 3td/8, 3td/4  (a = 1-√½, K' = K^¾)
+   *
+   * each normalized to a sum of one step.
+   */
+  void Stepper::refresh_shaping() {
+    shaping_train_t train[2];
+    LOOP_L_N(a, 2) {
+      const shaper_settings_t &ss = shaper_settings[a];
+      shaping_train_t &s = train[a];
+      s.echoes = 0;
+      s.weight[0] = SHAPING_UNIT;
+      if (ss.frequency > 0) {
+        const float df = SQRT(1.0f - sq(ss.zeta)), td = 1.0f / (_MAX(ss.frequency, SHAPING_MIN_FREQ) * df);
+        float amp[SHAPING_MAX_ECHOES + 1], when[SHAPING_MAX_ECHOES];
+        switch (ss.type) {
+          case SHAPER_ZV: {
+            const float K = expf(-ss.zeta * float(M_PI) / df);
+            s.echoes = 1;
+            amp[0] = 1; amp[1] = K;
+            when[0] = 0.5f * td;
+          } break;
+          case SHAPER_ZVD: {
+            const float K = expf(-ss.zeta * float(M_PI) / df);
+            s.echoes = 2;
+            amp[0] = 1; amp[1] = 2 * K; amp[2] = sq(K);
+            when[0] = 0.5f * td; when[1] = td;
+          } break;
+          default: { // SHAPER_MZV
+            const float K = expf(-0.75f * ss.zeta * float(M_PI) / df), a1 = 1.0f - SQRT(0.5f);
+            s.echoes = 2;
+            amp[0] = a1; amp[1] = (SQRT(2.0f) - 1.0f) * K; amp[2] = a1 * sq(K);
+            when[0] = 0.375f * td; when[1] = 0.75f * td;
+          } break;
+        }
+        float sum = 0;
+        for (uint8_t i = 0; i <= s.echoes; i++) sum += amp[i];
+        LOOP_L_N(e, s.echoes) {
+          s.weight[e + 1] = LROUND(amp[e + 1] * (SHAPING_UNIT) / sum);
+          s.weight[0] -= s.weight[e + 1];
+          s.delay[e] = LROUND(when[e] * (STEPPER_TIMER_RATE));
+        }
+      }
+    }
+
+    const bool was_enabled = STEPPER_ISR_ENABLED();
+    if (was_enabled) DISABLE_STEPPER_DRIVER_INTERRUPT();
+
+    // An axis still outputting echoes of the old train switches in shaping_isr()
+    LOOP_L_N(a, 2) {
+      const shaper_t &s = shaper[a];
+      shaping_next[a] = train[a];
+      SBI(shaping_next_bits, a);
+      if (!s.echoes || s.echo[s.echoes - 1] == s.head) shaping_install(AxisEnum(a));
+    }
+
+    if (was_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
+  }
+
+#endif // INPUT_SHAPING
+
+#if ENABLED(LEVELING_STREAM)
+
+  /**
+   * Leveling Stream
+   *
+   * The planner levels each move at its ends, so the Z motor follows a
+   * straight line between the mesh offsets there. At a fixed rate this
+   * looks up the mesh at the current XY position and steps Z toward the
+   * difference from that line. The difference is zero at both ends of a
+   * block, so the steppers end each move where the planner expects.
+   * The Z steps are counted in count_position as they are taken.
+   */
+  uint32_t Stepper::leveling_isr() {
+    int32_t target = 0;
+
+    const block_t * const block = current_block;
+    if (block && block->level_scale) {
+      const xy_pos_t pos = { count_position.x * planner.steps_to_mm[X_AXIS], count_position.y * planner.steps_to_mm[Y_AXIS] };
+      const float done = float(step_events_completed) / block->step_event_count;
+      target = LROUND(block->level_scale * bilinear_z_offset(pos, true) - block->level_start - block->level_delta * done);
+    }
+
+    if (target != leveling_steps) {
+      const bool reverse = target < leveling_steps,
+                 block_reverse = TEST(last_direction_bits, Z_AXIS);
+
+      // Set the DIR pin for the stream step, if the block steps the other way
+      if (reverse != block_reverse) {
+        #if MINIMUM_STEPPER_PRE_DIR_DELAY > 0
+          DELAY_NS(MINIMUM_STEPPER_PRE_DIR_DELAY);
+        #endif
+        Z_APPLY_DIR(reverse ? INVERT_Z_DIR : !INVERT_Z_DIR, false);
+        #if MINIMUM_STEPPER_POST_DIR_DELAY > 0
+          DELAY_NS(MINIMUM_STEPPER_POST_DIR_DELAY);
+        #endif
+      }
+
+      #if ISR_PULSE_CONTROL
+        hal_timer_t end_tick_count;
+      #endif
+
+      // Set the STEP pulse ON
+      Z_APPLY_STEP(!INVERT_Z_STEP_PIN, 0);
+
+      // Enforce a minimum duration for STEP pulse ON
+      #if ISR_PULSE_CONTROL
+        START_HIGH_PULSE();
+      #endif
+
+      if (reverse) { leveling_steps--; count_position.z--; }
+      else         { leveling_steps++; count_position.z++; }
+
+      #if ISR_PULSE_CONTROL
+        AWAIT_HIGH_PULSE();
+      #endif
+
+      // Set the STEP pulse OFF
+      Z_APPLY_STEP(INVERT_Z_STEP_PIN, 0);
+
+      // Restore the DIR pin for the block
+      if (reverse != block_reverse) {
+        #if ISR_PULSE_CONTROL
+          START_LOW_PULSE();
+          AWAIT_LOW_PULSE();
+        #endif
+        Z_APPLY_DIR(block_reverse ? INVERT_Z_DIR : !INVERT_Z_DIR, false);
+      }
+    }
+
+    return LEVELING_INTERVAL;
+  }
+
+#endif // LEVELING_STREAM
+
 // Check if the given block is busy or not - Must not be called from ISR contexts
 // The current_block could change in the middle of the read by an Stepper ISR, so
 // we must explicitly prevent that!
@@ -2329,6 +3245,9 @@ void Stepper::_set_position(const int32_t &a, const int32_t &b, const int32_t &c
     count_position.set(a, b, c);
   #endif
   count_position.e = e;
+  #if ENABLED(LEVELING_STREAM)
+    count_position.z += leveling_steps; // Stream steps still to be taken back
+  #endif
 }
 
 /**
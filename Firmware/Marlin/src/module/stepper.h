@@ -85,8 +85,8 @@
     #define ISR_LA_BASE_CYCLES 0UL
   #endif
 
-  // S curve interpolation adds 40 cycles
-  #if ENABLED(S_CURVE_ACCELERATION)
+  // S curve interpolation adds 40 cycles (none when the main loop precomputes it)
+  #if ENABLED(S_CURVE_ACCELERATION) && DISABLED(STEP_SCHEDULE)
     #define ISR_S_CURVE_CYCLES 40UL
   #else
     #define ISR_S_CURVE_CYCLES 0UL
@@ -233,6 +233,66 @@
 // The minimum allowable frequency for step smoothing will be 1/10 of the maximum nominal frequency (in Hz)
 #define MIN_STEP_ISR_FREQUENCY MAX_STEP_ISR_FREQUENCY_1X
 
+#if ENABLED(STEP_SCHEDULE)
+
+  // A run of Stepper ISRs sharing one interval
+  typedef struct {
+    uint32_t interval;          // Stepper timer ticks to the next ISR
+    uint16_t isr_count;         // Number of ISRs at this interval
+    uint8_t steps_per_isr;      // Step events done by each of these ISRs
+  } step_segment_t;
+
+  enum StepScheduleState : uint8_t { SCHEDULE_EMPTY, SCHEDULE_COMPILING, SCHEDULE_READY };
+
+  // The compiled pulse train of one planner block
+  typedef struct {
+    volatile uint8_t state;     // StepScheduleState - Checked by the Stepper ISR
+    uint8_t block_index,        // The planner block it belongs to
+            count;              // Segments in use
+    step_segment_t segment[STEP_SCHEDULE_SEGMENTS];
+  } step_schedule_t;
+
+  // Pulse train slots for the busy block and the ones compiled ahead of it, indexed by
+  // block index. A power of 2 so the blocks in that window always get distinct slots.
+  #define STEP_SCHEDULE_SLOTS ((STEP_SCHEDULE_LOOKAHEAD) < 2 ? 2 : (STEP_SCHEDULE_LOOKAHEAD) < 4 ? 4 : (STEP_SCHEDULE_LOOKAHEAD) < 8 ? 8 : 16)
+
+#endif
+
+#if ENABLED(INPUT_SHAPING)
+
+  enum ShaperType : uint8_t { SHAPER_ZV, SHAPER_ZVD, SHAPER_MZV };
+
+  // Shaper settings of one axis, as set by M593
+  typedef struct {
+    float frequency,            // Ringing frequency (Hz), 0 for no shaping
+          zeta;                 // Damping ratio
+    uint8_t type;               // ShaperType
+  } shaper_settings_t;
+
+  #define SHAPING_MAX_ECHOES 2  // Impulses after the first one
+  #define SHAPING_UNIT 1024     // Impulse weight of a whole step
+  #define SHAPING_MIN_FREQ 1    // (Hz) Lower, the echo delays could overflow the timer math
+
+  // Impulse train and pending echoes of one shaped axis
+  typedef struct {
+    uint8_t echoes;                                 // Delayed impulses, 0 for no shaping
+    int16_t weight[SHAPING_MAX_ECHOES + 1],         // Impulse weights, summing to SHAPING_UNIT
+            accum;                                  // Weight not yet output as steps
+    uint32_t delay[SHAPING_MAX_ECHOES];             // Echo delays in Stepper timer ticks, ascending
+    uint16_t head,                                  // Where the next input step goes
+             echo[SHAPING_MAX_ECHOES];              // Next input step each echo replays
+    uint32_t step_time[SHAPING_BUFFER_SIZE];        // Input step times, with bit 0 set for reverse steps
+  } shaper_t;
+
+  // Impulse train waiting for the pending echoes of an axis to finish
+  typedef struct {
+    uint8_t echoes;
+    int16_t weight[SHAPING_MAX_ECHOES + 1];
+    uint32_t delay[SHAPING_MAX_ECHOES];
+  } shaping_train_t;
+
+#endif
+
 //
 // Stepper class definition
 //
@@ -310,30 +370,69 @@ class Stepper {
     #endif
 
     #if ENABLED(S_CURVE_ACCELERATION)
-      static int32_t bezier_A,     // A coefficient in Bézier speed curve
-                     bezier_B,     // B coefficient in Bézier speed curve
-                     bezier_C;     // C coefficient in Bézier speed curve
+      #if ENABLED(S_CURVE_LOOKUP_TABLE)
+        static int32_t bezier_dv;  // Speed change over the Bézier speed curve
+      #else
+        static int32_t bezier_A,   // A coefficient in Bézier speed curve
+                       bezier_B,   // B coefficient in Bézier speed curve
+                       bezier_C;   // C coefficient in Bézier speed curve
+      #endif
       static uint32_t bezier_F,    // F coefficient in Bézier speed curve
                       bezier_AV;   // AV coefficient in Bézier speed curve
       #ifdef __AVR__
         static bool A_negative;    // If A coefficient was negative
       #endif
       static bool bezier_2nd_half; // If Bézier curve has been initialized or not
+      #if ENABLED(S_CURVE_JUNCTIONS)
+        static int32_t bezier_J0,  // Start slope of the Bézier speed curve, carried from the last block
+                       bezier_J1;  // End slope of the Bézier speed curve, carried into the next block
+        static uint16_t ramp_in,   // Share of the block acceleration kept at its start (Q14)
+                        ramp_out;  // Share of the block acceleration kept at its end (Q14)
+        static int16_t junction_carry; // ramp_in of the next block, negative if it starts braking
+      #endif
     #endif
 
     static uint32_t nextMainISR;   // time remaining for the next Step ISR
-    #if ENABLED(LIN_ADVANCE)
+    #if HAS_ADVANCE_ISR
       static uint32_t nextAdvanceISR, LA_isr_rate;
       static uint16_t LA_current_adv_steps, LA_final_adv_steps, LA_max_adv_steps; // Copy from current executed block. Needed because current_block is set to NULL "too early".
       static int8_t LA_steps;
       static bool LA_use_advance_lead;
+    #elif ENABLED(LA_PRESSURE_SMOOTHING)
+      static uint32_t la_coeff;             // Advance per step event rate, from the current block
+      static int32_t la_advance,            // Smoothed advance in 1/256 E steps
+                     la_pending;            // E steps owed to the extruder, negative to pull back
+      static int16_t la_advance_steps;      // Whole steps of the advance already added to la_pending
+      static uint32_t la_interval;          // Block phase interval of the last pressure_update
+      static int8_t la_direction;           // E DIR set by the pulse phase, or 0 if not set yet
     #endif // LIN_ADVANCE
 
+    #if ENABLED(INPUT_SHAPING)
+      static uint32_t nextShapingISR,       // Time remaining for the next echo
+                      shaping_clock;        // Stepper timer ticks at the current ISR event
+      static shaper_t shaper[2];            // X and Y
+      static uint8_t shaping_direction_bits; // X and Y DIR pin states, as set by the shaper
+      static shaping_train_t shaping_next[2]; // Trains set by refresh_shaping() and not yet in use
+      static uint8_t shaping_next_bits;     // Axes with a train in shaping_next
+    #endif
+
+    #if ENABLED(LEVELING_STREAM)
+      static uint32_t nextLevelingISR;      // Time remaining for the next mesh lookup
+      static int16_t leveling_steps;        // Z steps of the leveling stream not yet taken back
+    #endif
+
     static int32_t ticks_nominal;
     #if DISABLED(S_CURVE_ACCELERATION)
       static uint32_t acc_step_rate; // needed for deceleration start point
     #endif
 
+    #if ENABLED(STEP_SCHEDULE)
+      static step_schedule_t schedule[STEP_SCHEDULE_SLOTS]; // Pulse trains of the next blocks
+      static const step_segment_t *schedule_segment,        // Segment in use, nullptr if the block has no schedule
+                                  *schedule_end;
+      static uint16_t schedule_isrs_left;                   // ISRs left in the current segment
+    #endif
+
     //
     // Exact steps at which an endstop was triggered
     //
@@ -370,14 +469,59 @@ class Stepper {
     // The stepper block processing phase ISR
     static uint32_t stepper_block_phase_isr();
 
-    #if ENABLED(LIN_ADVANCE)
+    #if HAS_ADVANCE_ISR
       // The Linear advance stepper ISR
       static uint32_t advance_isr();
+    #elif ENABLED(LA_PRESSURE_SMOOTHING)
+      // Follow the extruder speed with the advance
+      static void pressure_update(const uint32_t interval);
+      static void pressure_direction(const int8_t dir);
+      static void pressure_step();
+      static uint32_t pressure_release();
+    #endif
+
+    #if ENABLED(INPUT_SHAPING)
+      // The input shaper echo ISR
+      static uint32_t shaping_isr();
+
+      static shaper_settings_t shaper_settings[2]; // X and Y, as set by M593
+
+      // Apply shaper_settings to the Stepper ISR. An axis with echoes
+      // pending switches over once they are all out.
+      static void refresh_shaping();
+
+      // Input shaper echoes are still to be output
+      static bool input_shaping_busy();
+    #endif
+
+    #if ENABLED(LEVELING_STREAM)
+      // The leveling Z step stream ISR
+      static uint32_t leveling_isr();
+
+      // Leveling stream Z steps are still to be taken back
+      FORCE_INLINE static bool leveling_stream_busy() { return leveling_steps != 0; }
+    #endif
+
+    #if ENABLED(LA_PRESSURE_SMOOTHING)
+      // E steps of the advance, or owed from the last blocks, are still to go out
+      FORCE_INLINE static bool pressure_busy() { return la_pending || la_advance_steps; }
     #endif
 
     // Check if the given block is busy or not - Must not be called from ISR contexts
     static bool is_block_busy(const block_t* const block);
 
+    #if ENABLED(STEP_SCHEDULE)
+      // Compile the pulse trains of the next blocks for the ISR - Called from idle()
+      static void schedule_ahead();
+
+      // Forget a block's pulse train when its trapezoid changes - Not for ISR contexts
+      FORCE_INLINE static void schedule_invalidate(const block_t * const block) {
+        const uint8_t b = block - planner.block_buffer;
+        step_schedule_t &sched = schedule_slot(b);
+        if (sched.block_index == b) sched.state = SCHEDULE_EMPTY;
+      }
+    #endif
+
     // Get the position of a stepper, in steps
     static int32_t position(const AxisEnum axis);
 
@@ -553,6 +697,36 @@ class Stepper {
     #if ENABLED(S_CURVE_ACCELERATION)
       static void _calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av);
       static int32_t _eval_bezier_curve(const uint32_t curr_step);
+      #if ENABLED(S_CURVE_JUNCTIONS)
+        static void plan_junction_ramps();
+        static void _calc_bezier_junction(const int32_t dv, const uint16_t r0, const uint16_t r1);
+        static int32_t _eval_bezier_junction(const uint32_t curr_step);
+      #endif
+    #endif
+
+    #if ENABLED(STEP_SCHEDULE)
+      FORCE_INLINE static step_schedule_t& schedule_slot(const uint8_t block_index) {
+        return schedule[block_index & (STEP_SCHEDULE_SLOTS - 1)];
+      }
+
+      static bool schedule_compile(const block_t * const block, step_schedule_t &sched);
+
+      // Interval to the next ISR from the precomputed pulse train
+      FORCE_INLINE static uint32_t schedule_next_interval() {
+        if (!schedule_isrs_left && schedule_segment + 1 < schedule_end)
+          schedule_isrs_left = (++schedule_segment)->isr_count;
+        if (schedule_isrs_left) --schedule_isrs_left;
+        steps_per_isr = schedule_segment->steps_per_isr;
+        return schedule_segment->interval;
+      }
+    #endif
+
+    #if ENABLED(INPUT_SHAPING)
+      static bool shaping_input(const AxisEnum axis);
+      static bool shaping_output(const AxisEnum axis, const int16_t weight);
+      static void shaping_set_direction(const AxisEnum axis, const bool reverse);
+      static void shaping_abort();
+      static void shaping_install(const AxisEnum axis);
     #endif
 
     #if HAS_DIGIPOTSS || HAS_MOTOR_CURRENT_PWM
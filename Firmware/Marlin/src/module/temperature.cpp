@@ -78,6 +78,10 @@
 
 #include "printcounter.h"
 
+#if ENABLED(BUFFER_MONITORING)
+  #include "../feature/buffer_monitor.h"
+#endif
+
 #if ENABLED(FILAMENT_WIDTH_SENSOR)
   #include "../feature/filwidth.h"
 #endif
@@ -3197,6 +3201,9 @@ void Temperature::tick() {
 
         idle();
         gcode.reset_stepper_timeout(); // Keep steppers powered
+        #if ENABLED(BUFFER_MONITORING)
+          buffer_monitor.waiting();
+        #endif
 
         const float temp = degHotend(target_extruder);
 
@@ -3321,6 +3328,9 @@ void Temperature::tick() {
 
         idle();
         gcode.reset_stepper_timeout(); // Keep steppers powered
+        #if ENABLED(BUFFER_MONITORING)
+          buffer_monitor.waiting();
+        #endif
 
         const float temp = degBed();
 
@@ -3433,6 +3443,9 @@ void Temperature::tick() {
 
         idle();
         gcode.reset_stepper_timeout(); // Keep steppers powered
+        #if ENABLED(BUFFER_MONITORING)
+          buffer_monitor.waiting();
+        #endif
 
         const float temp = degChamber();
 
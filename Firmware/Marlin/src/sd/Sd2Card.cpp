@@ -89,6 +89,10 @@
 
 // Send command and return error code. Return zero for OK
 uint8_t Sd2Card::cardCommand(const uint8_t cmd, const uint32_t arg) {
+  #if ENABLED(SD_READ_AHEAD)
+    if (streaming()) streamStop(); // The card is busy sending blocks
+  #endif
+
   // Select card
   chipSelect();
 
@@ -485,6 +489,101 @@ bool Sd2Card::readStart(uint32_t blockNumber) {
   return success;
 }
 
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Start a read multiple blocks sequence whose blocks are then taken one at
+   * a time with streamBlock() and streamPoll(). The main loop goes on while
+   * the card looks up the block and the SPI (by DMA, if the HAL can) takes
+   * it in. Any other command first ends the sequence with streamStop().
+   *
+   * \param[in] blockNumber Address of first block in sequence.
+   *
+   * \return true for success, false for failure.
+   */
+  bool Sd2Card::streamStart(const uint32_t blockNumber) {
+    if (!readStart(blockNumber)) return false;
+    stream_state_ = STREAM_IDLE;
+    return true;
+  }
+
+  /**
+   * Begin to read the next block of the sequence. Poll for the end.
+   *
+   * \param[out] dst Pointer to the location for the data to be read.
+   */
+  void Sd2Card::streamBlock(uint8_t* dst) {
+    stream_dst_ = dst;
+    stream_timeout_ = millis() + SD_READ_TIMEOUT;
+    stream_state_ = STREAM_TOKEN;
+  }
+
+  /**
+   * Move the block read along.
+   *
+   * \return 1 when the block is in, 0 while it isn't, -1 on failure
+   * (which also ends the sequence).
+   */
+  int8_t Sd2Card::streamPoll() {
+    switch (stream_state_) {
+      case STREAM_TOKEN:
+        chipSelect();
+        for (uint8_t i = 8; i--;) {                 // Look at a few bytes for the start block token
+          status_ = spiRec();
+          if (status_ == 0xFF) continue;
+          if (status_ != DATA_START_BLOCK) {
+            error(SD_CARD_ERROR_READ);
+            break;
+          }
+          spiReadStart(stream_dst_, 512);           // The card stays selected for the transfer
+          stream_state_ = STREAM_DATA;
+          return 0;
+        }
+        chipDeselect();
+        if (status_ == 0xFF) {
+          if (PENDING(millis(), stream_timeout_)) return 0;
+          error(SD_CARD_ERROR_READ_TIMEOUT);
+        }
+        break;
+
+      case STREAM_DATA: {
+        if (spiReadBusy()) return 0;
+        const uint16_t recvCrc = (spiRec() << 8) | spiRec();
+        chipDeselect();
+        stream_state_ = STREAM_IDLE;
+        #if ENABLED(SD_CHECK_AND_RETRY)
+          if (crcSupported && recvCrc != CRC_CCITT(stream_dst_, 512)) {
+            error(SD_CARD_ERROR_READ_CRC);
+            break;
+          }
+        #else
+          UNUSED(recvCrc);
+        #endif
+        return 1;
+      }
+
+      default: return -1;                           // No block was asked for
+    }
+    streamStop();
+    return -1;
+  }
+
+  /**
+   * End the read multiple blocks sequence, after the block being
+   * transferred, if any.
+   */
+  void Sd2Card::streamStop() {
+    if (stream_state_ == STREAM_OFF) return;
+    if (stream_state_ == STREAM_DATA) {
+      while (spiReadBusy()) { /* nada */ }
+      spiRec(); spiRec();                           // CRC
+    }
+    stream_state_ = STREAM_OFF;
+    readStop();
+  }
+
+#endif // SD_READ_AHEAD
+
 /**
  * End a read multiple blocks sequence.
  *
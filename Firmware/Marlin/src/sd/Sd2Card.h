@@ -159,6 +159,15 @@ public:
   bool writeStart(uint32_t blockNumber, const uint32_t eraseCount);
   bool writeStop();
 
+  #if ENABLED(SD_READ_AHEAD)
+    // Multiple block read in the background. Any other command ends it.
+    bool streamStart(const uint32_t blockNumber);
+    void streamBlock(uint8_t* dst);
+    int8_t streamPoll();
+    void streamStop();
+    inline bool streaming() const { return stream_state_ != STREAM_OFF; }
+  #endif
+
 private:
   uint8_t chipSelectPin_,
           errorCode_,
@@ -166,6 +175,13 @@ private:
           status_,
           type_;
 
+  #if ENABLED(SD_READ_AHEAD)
+    enum StreamState : uint8_t { STREAM_OFF, STREAM_IDLE, STREAM_TOKEN, STREAM_DATA };
+    StreamState stream_state_ = STREAM_OFF;
+    uint8_t *stream_dst_;
+    millis_t stream_timeout_;
+  #endif
+
   // private functions
   inline uint8_t cardAcmd(const uint8_t cmd, const uint32_t arg) {
     cardCommand(CMD55, 0);
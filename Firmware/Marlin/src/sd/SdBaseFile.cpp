@@ -1038,6 +1038,42 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
   return nbyte;
 }
 
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Move past the block at the current position, which must be
+   * block-aligned, to read it some other way (see CardReader::read_ahead).
+   *
+   * \param[out] block The raw device block number.
+   *
+   * \return The bytes of the file in the block, zero at the end
+   * of the file, or -1 on error.
+   */
+  int16_t SdBaseFile::nextBlock(uint32_t &block) {
+    if (!isOpen() || !(flags_ & O_READ) || (curPosition_ & 0x1FF)) return -1;
+
+    const uint16_t n = _MIN(fileSize_ - curPosition_, 512UL);
+    if (!n) return 0;
+
+    if (type_ == FAT_FILE_TYPE_ROOT_FIXED)
+      block = vol_->rootDirStart() + (curPosition_ >> 9);
+    else {
+      const uint8_t blockOfCluster = vol_->blockOfCluster(curPosition_);
+      if (blockOfCluster == 0) {
+        // start of new cluster
+        if (curPosition_ == 0)
+          curCluster_ = firstCluster_;
+        else if (!vol_->fatGet(curCluster_, &curCluster_))
+          return -1;
+      }
+      block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
+    }
+    curPosition_ += n;
+    return n;
+  }
+
+#endif // SD_READ_AHEAD
+
 /**
  * Read the next entry in a directory.
  *
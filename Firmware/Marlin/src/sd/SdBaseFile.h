@@ -301,6 +301,9 @@ class SdBaseFile {
   bool printName();
   int16_t read();
   int16_t read(void* buf, uint16_t nbyte);
+  #if ENABLED(SD_READ_AHEAD)
+    int16_t nextBlock(uint32_t &block);
+  #endif
   int8_t readDir(dir_t* dir, char* longFilename);
   static bool remove(SdBaseFile* dirFile, const char* path);
   bool remove();
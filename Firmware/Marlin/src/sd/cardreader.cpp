@@ -56,6 +56,10 @@ int8_t CardReader::autostart_index;
   int8_t CardReader::transfer_port_index;
 #endif
 
+#if ENABLED(G29_PRINT_AREA)
+  xy_pos_t CardReader::print_area_min, CardReader::print_area_max;
+#endif
+
 // private:
 
 SdFile CardReader::root, CardReader::workDir, CardReader::workDirParents[MAX_DIR_DEPTH];
@@ -113,6 +117,24 @@ char CardReader::proc_filenames[SD_PROCEDURE_DEPTH][MAXPATHNAMELENGTH];
 
 uint32_t CardReader::filesize, CardReader::sdpos;
 
+#if ENABLED(SD_BLOCK_READER)
+  #if ENABLED(SD_READ_AHEAD)
+    uint8_t *CardReader::read_buf; // = nullptr
+  #else
+    uint8_t CardReader::read_buf[512];
+  #endif
+  uint16_t CardReader::read_len, CardReader::read_ofs;
+  uint32_t CardReader::read_pos;
+#endif
+
+#if ENABLED(SD_READ_AHEAD)
+  uint8_t *CardReader::ahead_buf; // = nullptr
+  uint16_t CardReader::ahead_len[SD_READ_AHEAD_BLOCKS];
+  uint8_t CardReader::ahead_head, CardReader::ahead_count;
+  bool CardReader::ahead_reading;
+  uint32_t CardReader::ahead_next;
+#endif
+
 CardReader::CardReader() {
   #if ENABLED(SDCARD_SORT_ALPHA)
     sort_count = 0;
@@ -488,7 +510,7 @@ void CardReader::openFileRead(char * const path, const uint8_t subcall_type/*=0*
 
       // Store current filename (based on workDirParents) and position
       getAbsFilename(proc_filenames[file_subcall_ctr]);
-      filespos[file_subcall_ctr] = sdpos;
+      filespos[file_subcall_ctr] = getResumeIndex();
 
       // For sub-procedures say 'SUBROUTINE CALL target: "..." parent: "..." pos12345'
       SERIAL_ECHO_START();
@@ -510,9 +532,20 @@ void CardReader::openFileRead(char * const path, const uint8_t subcall_type/*=0*
   if (file.open(curDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    #if ENABLED(SD_BLOCK_READER)
+      read_reset(0);
+    #endif
     SERIAL_ECHOLNPAIR(MSG_SD_FILE_OPENED, fname, MSG_SD_SIZE, filesize);
     SERIAL_ECHOLNPGM(MSG_SD_FILE_SELECTED);
 
+    #if ENABLED(G29_PRINT_AREA)
+      if (subcall_type == 0) read_print_area();
+    #endif
+
+    #if ENABLED(BINARY_GCODE)
+      check_binary_gcode();
+    #endif
+
     selectFileByName(fname);
     ui.set_status(longFilename[0] ? longFilename : fname);
   }
@@ -520,6 +553,186 @@ void CardReader::openFileRead(char * const path, const uint8_t subcall_type/*=0*
     openFailed(fname);
 }
 
+#if ENABLED(G29_PRINT_AREA)
+
+  /**
+   * Look for the extent of the print in the header of a newly opened file,
+   * as written by Cura: ";MINX:<x>", ";MINY:<y>", ";MAXX:<x>", ";MAXY:<y>".
+   * 'G29 U' uses it to probe just the print area.
+   */
+  void CardReader::read_print_area() {
+    char line[24];
+    uint8_t len = 0, found = 0;
+    for (uint16_t n = 0; n < PRINT_AREA_HEADER_BYTES && found != 0x0F; n++) {
+      const int16_t c = file.read();
+      if (c < 0) break;
+      if (c != '\n' && c != '\r') {
+        if (len < COUNT(line) - 1) line[len++] = c;
+        continue;
+      }
+      line[len] = '\0';
+      const bool is_key = len > 6 && line[0] == ';';
+      len = 0;
+      if (!is_key) continue;
+      const float v = atof(&line[6]);
+      if      (strstr_P(line, PSTR(";MINX:")) == line) { print_area_min.x = v; SBI(found, 0); }
+      else if (strstr_P(line, PSTR(";MINY:")) == line) { print_area_min.y = v; SBI(found, 1); }
+      else if (strstr_P(line, PSTR(";MAXX:")) == line) { print_area_max.x = v; SBI(found, 2); }
+      else if (strstr_P(line, PSTR(";MAXY:")) == line) { print_area_max.y = v; SBI(found, 3); }
+    }
+    flag.print_area = found == 0x0F;
+    file.seekSet(0);
+  }
+
+#endif // G29_PRINT_AREA
+
+#if ENABLED(BINARY_GCODE)
+
+  /**
+   * A pre-tokenized file starts with BINARY_GCODE_HEADER. Set the flag
+   * and start after the header, or start at the top of a G-code file.
+   */
+  void CardReader::check_binary_gcode() {
+    uint8_t head[4];
+    flag.binary_gcode = file.read(head, 4) == 4 && !memcmp(head, BINARY_GCODE_HEADER, 4);
+    setIndex(flag.binary_gcode ? 4 : 0);
+  }
+
+#endif // BINARY_GCODE
+
+#if ENABLED(SD_BLOCK_READER)
+
+  /**
+   * Read the file up to the end of the next block. Reads after the first
+   * are whole aligned blocks, which SdBaseFile reads straight into the buffer
+   * without going through the volume cache.
+   * Return false at the end of the file or on a read error.
+   */
+  bool CardReader::read_fill() {
+    read_pos += read_len;
+    read_len = read_ofs = 0;
+
+    #if ENABLED(SD_READ_AHEAD)
+
+      if (read_buf) {                   // Done with the block in use
+        read_buf = nullptr;
+        ahead_head = (ahead_head + 1) % (SD_READ_AHEAD_BLOCKS);
+        ahead_count--;
+      }
+
+      // Usually the next block is in by now. If not, wait for it.
+      for (uint8_t tries = 3; !ahead_count;) {
+        const int8_t r = read_ahead();
+        if (!r || (r < 0 && !--tries)) return false;
+      }
+
+      read_buf = ahead_buf + ahead_head * 512U;
+      read_len = ahead_len[ahead_head];
+
+    #else
+
+      const int16_t n = file.read(read_buf, sizeof(read_buf) - (read_pos & (sizeof(read_buf) - 1)));
+      if (n <= 0) return false;
+      read_len = n;
+
+    #endif
+
+    return true;
+  }
+
+  /**
+   * Skip the rest of a line (i.e., a comment) up to its end,
+   * so the next get() returns the '\n' or '\r'.
+   */
+  void CardReader::skip_line() {
+    for (;;) {
+      while (read_ofs < read_len) {
+        const uint8_t c = read_buf[read_ofs];
+        if (c == '\n' || c == '\r') return;
+        read_ofs++;
+      }
+      if (!read_fill()) return;
+    }
+  }
+
+#endif // SD_BLOCK_READER
+
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Keep the ring of blocks after the one in use filled with a multiple
+   * block read. The card looks up the next block and the SPI takes it in
+   * while the main loop gets on with other things, so the queue rarely has
+   * to wait for the card. A jump in the device blocks (a fragmented file) or
+   * any other SD command ends the stream, and a new one is started.
+   * Return 1 while there's progress, 0 at the end of the file, -1 on error.
+   */
+  int8_t CardReader::read_ahead() {
+    if (!ahead_buf) {
+      ahead_buf = (uint8_t*)malloc((SD_READ_AHEAD_BLOCKS) * 512U); // On LPC176x the heap is in reach of the GPDMA
+      if (!ahead_buf) return -1;
+    }
+
+    uint8_t slot = (ahead_head + ahead_count) % (SD_READ_AHEAD_BLOCKS);
+
+    if (ahead_reading) {
+      const int8_t r = sd2card.streamPoll();
+      if (!r) return 1;
+      ahead_reading = false;
+      if (r < 0) {
+        file.seekSet(file.curPosition() - ahead_len[slot]); // Try this block again
+        return -1;
+      }
+      ahead_count++;
+      slot = (slot + 1) % (SD_READ_AHEAD_BLOCKS);
+    }
+
+    while (ahead_count < SD_READ_AHEAD_BLOCKS) {
+      uint8_t * const dst = ahead_buf + slot * 512U;
+      const uint16_t ofs = file.curPosition() & 0x1FF;
+
+      if (ofs) {                        // Not at a block start (after setIndex). Read to the end of the block.
+        const int16_t n = file.read(dst, 512 - ofs);
+        if (n <= 0) return ahead_count ? 1 : n;
+        ahead_len[slot] = n;
+        ahead_count++;
+        slot = (slot + 1) % (SD_READ_AHEAD_BLOCKS);
+        continue;
+      }
+
+      uint32_t block;
+      const int16_t n = file.nextBlock(block);
+      if (n <= 0) return ahead_count ? 1 : n;
+      ahead_len[slot] = n;
+
+      if (!sd2card.streaming() || block != ahead_next) {
+        sd2card.streamStop();
+        if (!sd2card.streamStart(block)) {
+          file.seekSet(file.curPosition() - n);
+          return -1;
+        }
+      }
+      ahead_next = block + 1;
+      sd2card.streamBlock(dst);
+      ahead_reading = true;
+      return 1;
+    }
+
+    return 1;
+  }
+
+  // Drop the blocks read ahead, for reading from another place
+  void CardReader::read_reset(const uint32_t pos) {
+    read_pos = pos;
+    read_len = read_ofs = 0;
+    read_buf = nullptr;
+    sd2card.streamStop();
+    ahead_reading = false;
+    ahead_head = ahead_count = 0;
+  }
+
+#endif // SD_READ_AHEAD
+
 //
 // Open a file by DOS path for write
 //
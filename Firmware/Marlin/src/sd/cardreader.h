@@ -31,6 +31,10 @@
 #define MAXDIRNAMELENGTH   8       // DOS folder name size
 #define MAXPATHNAMELENGTH  (1 + (MAXDIRNAMELENGTH + 1) * (MAX_DIR_DEPTH) + 1 + FILENAME_LENGTH) // "/" + N * ("ADIRNAME/") + "filename.ext"
 
+#if ENABLED(BINARY_GCODE)
+  #define BINARY_GCODE_HEADER "MGB\x01"  // Pre-tokenized G-code, format 1
+#endif
+
 #include "SdFile.h"
 
 typedef struct {
@@ -44,6 +48,12 @@ typedef struct {
        #if ENABLED(BINARY_FILE_TRANSFER)
          , binary_mode:1
        #endif
+       #if ENABLED(G29_PRINT_AREA)
+         , print_area:1
+       #endif
+       #if ENABLED(BINARY_GCODE)
+         , binary_gcode:1
+       #endif
     ;
 } card_flags_t;
 
@@ -62,6 +72,10 @@ public:
     #endif
   #endif
 
+  #if ENABLED(G29_PRINT_AREA)
+    static xy_pos_t print_area_min, print_area_max; // Extent of the print, from the file header
+  #endif
+
   // // // Methods // // //
 
   CardReader();
@@ -147,10 +161,31 @@ public:
 
   static inline bool isFileOpen() { return isMounted() && file.isOpen(); }
   static inline uint32_t getIndex() { return sdpos; }
+  // Where reading can go on from later. A binary record has no line end to read again.
+  static inline uint32_t getResumeIndex() {
+    return sdpos
+      #if ENABLED(BINARY_GCODE)
+        + flag.binary_gcode
+      #endif
+    ;
+  }
   static inline bool eof() { return sdpos >= filesize; }
-  static inline void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); }
   static inline char* getWorkDirName() { workDir.getDosName(filename); return filename; }
-  static inline int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
+  #if ENABLED(SD_BLOCK_READER)
+    static inline void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); read_reset(index); }
+    static inline int16_t get() {
+      if (read_ofs >= read_len && !read_fill()) { sdpos = read_pos + read_ofs; return -1; }
+      sdpos = read_pos + read_ofs;
+      return read_buf[read_ofs++];
+    }
+    static void skip_line();
+    #if ENABLED(SD_READ_AHEAD)
+      static int8_t read_ahead();
+    #endif
+  #else
+    static inline void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); }
+    static inline int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
+  #endif
   static inline int16_t read(void* buf, uint16_t nbyte) { return file.isOpen() ? file.read(buf, nbyte) : -1; }
   static inline int16_t write(void* buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
 
@@ -237,6 +272,37 @@ private:
 
   static uint32_t filesize, sdpos;
 
+  //
+  // Block buffer for reading the printed file
+  //
+  #if ENABLED(SD_BLOCK_READER)
+    #if ENABLED(SD_READ_AHEAD)
+      static uint8_t *read_buf;           // The read-ahead block in use, if any
+    #else
+      static uint8_t read_buf[512];       // Data from the file, up to the end of a block
+    #endif
+    static uint16_t read_len, read_ofs;   // Bytes in read_buf, and the next to get
+    static uint32_t read_pos;             // File position of read_buf[0]
+    #if ENABLED(SD_READ_AHEAD)
+      static void read_reset(const uint32_t pos);
+    #else
+      static inline void read_reset(const uint32_t pos) { read_pos = pos; read_len = read_ofs = 0; }
+    #endif
+    static bool read_fill();
+  #endif
+
+  //
+  // Ring of blocks read ahead of read_buf by CMD18 (Sd2Card::streamStart)
+  //
+  #if ENABLED(SD_READ_AHEAD)
+    static uint8_t *ahead_buf;                        // SD_READ_AHEAD_BLOCKS blocks, from the heap
+    static uint16_t ahead_len[SD_READ_AHEAD_BLOCKS];  // Bytes of the file in each block
+    static uint8_t ahead_head,                        // The first block read in (the one in use, if any)
+                   ahead_count;                       // Blocks read in, from ahead_head on
+    static bool ahead_reading;                        // The block after those is coming in
+    static uint32_t ahead_next;                       // Device block the card sends next
+  #endif
+
   //
   // Procedure calls to other files
   //
@@ -270,6 +336,14 @@ private:
   #if ENABLED(SDCARD_SORT_ALPHA)
     static void flush_presort();
   #endif
+
+  #if ENABLED(G29_PRINT_AREA)
+    static void read_print_area();
+  #endif
+
+  #if ENABLED(BINARY_GCODE)
+    static void check_binary_gcode();
+  #endif
 };
 
 #if ENABLED(USB_FLASH_DRIVE_SUPPORT)
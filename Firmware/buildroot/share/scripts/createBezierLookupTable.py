@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+
+""" Generate the S-curve lookup table for Marlin firmware.
+
+S_CURVE_LOOKUP_TABLE evaluates the Bezier speed curve of the Stepper ISR as
+
+  v(t) = v0 + (v1 - v0) * s(t),  s(t) = 10t^3 - 15t^4 + 6t^5
+
+with s(t) read from a table of 257 points in Q16 and linearly interpolated.
+This script writes that table (Marlin/src/module/bezier_lookuptable.h).
+
+With --check it instead runs the table evaluator and the current 32-bit
+evaluator (the math of Stepper::_eval_bezier_curve) bit-exactly over a sweep
+of ramps, and reports the error of each against the exact curve at the same t.
+"""
+
+from __future__ import print_function
+from __future__ import division
+
+import argparse
+import random
+
+BITS = 8                      # 2^BITS table intervals
+SIZE = 1 << BITS
+
+def s(x):
+  return x * x * x * (10 + x * (-15 + x * 6))
+
+LICENSE = """/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+"""
+
+TABLE = [int(round(s(i / SIZE) * 65536)) for i in range(SIZE + 1)]
+
+def period_inverse(d):
+  return 0xFFFFFFFF // d if d else 0xFFFFFFFF
+
+def eval_current(v0, v1, av, step):
+  # Stepper::_eval_bezier_curve (32-bit), 128x scaled coefficients
+  a, b, c, f = 768 * (v1 - v0), 1920 * (v0 - v1), 1280 * (v1 - v0), 128 * v0
+  t = (av * step) & 0xFFFFFFFF
+  p = t
+  p = (p * t) >> 32
+  p = (p * t) >> 32
+  acc = f << 31
+  acc += (p >> 1) * c
+  p = (p * t) >> 32
+  acc += (p >> 1) * b
+  p = (p * t) >> 32
+  acc += (p >> 1) * a
+  return acc >> 38
+
+def eval_table(v0, v1, av, step):
+  # bezier_table_eval() in stepper.cpp
+  t = (av * step) & 0xFFFFFFFF
+  i, frac = t >> (32 - BITS), (t >> (16 - BITS)) & 0xFFFF
+  s0 = TABLE[i]
+  st = s0 + (((TABLE[i + 1] - s0) * frac) >> 16)
+  return v0 + (((v1 - v0) * st + 0x8000) >> 16)
+
+def eval_exact(v0, v1, av, step):
+  # Exact curve at the same time fraction t the ISR computes
+  return v0 + (v1 - v0) * s(((av * step) & 0xFFFFFFFF) / 2**32)
+
+def check(ramps, timer_rate):
+  random.seed(1)
+  worst = { 'current': [0, 0], 'table': [0, 0] }  # abs steps/s, relative to |v1-v0|
+  diff = 0
+  for _ in range(ramps):
+    v0 = random.randint(120, 250000)
+    v1 = random.randint(120, 250000)
+    accel = random.choice((500, 1500, 3000, 10000)) * random.choice((80, 400, 800))
+    ts = max(1, int(abs(v1 - v0) / accel * timer_rate))
+    av = period_inverse(ts)
+    for step in range(0, ts, max(1, ts // 2000)):
+      exact = eval_exact(v0, v1, av, step)
+      cur, tab = eval_current(v0, v1, av, step), eval_table(v0, v1, av, step)
+      for name, v in (('current', cur), ('table', tab)):
+        err = abs(v - exact)
+        worst[name][0] = max(worst[name][0], err)
+        if abs(v1 - v0) >= 1000: worst[name][1] = max(worst[name][1], err / abs(v1 - v0))
+      diff = max(diff, abs(cur - tab))
+  print("%d ramps, timer rate %d Hz" % (ramps, timer_rate))
+  for name in ('current', 'table'):
+    print("%-8s max error %8.2f steps/s  %.6f%% of the speed change (ramps over 1000 steps/s)" % (name, worst[name][0], worst[name][1] * 100))
+  print("table vs current: max difference %d steps/s" % diff)
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument('--check', action='store_true', help='compare the evaluators instead of printing the table')
+  parser.add_argument('-n', '--ramps', type=int, default=2000, help='ramps to check (default=%(default)s)')
+  parser.add_argument('-r', '--timer-rate', type=int, default=2000000, help='stepper timer rate in Hz (default=%(default)s)')
+  args = parser.parse_args()
+
+  if args.check:
+    check(args.ramps, args.timer_rate)
+    return
+
+  print(LICENSE)
+  print("/**")
+  print(" * S-curve lookup table, generated by buildroot/share/scripts/createBezierLookupTable.py")
+  print(" *")
+  print(" * s(t) = 10t^3 - 15t^4 + 6t^5 at t = i/%d, in Q16" % SIZE)
+  print(" */")
+  print()
+  print("#define BEZIER_TABLE_BITS %d" % BITS)
+  print()
+  print("const uint32_t bezier_lookuptable[%d] = {" % (SIZE + 1))
+  for i in range(0, SIZE + 1, 8):
+    print("  " + " ".join("%5d," % v for v in TABLE[i:i + 8]))
+  print("};")
+
+if __name__ == '__main__':
+  main()
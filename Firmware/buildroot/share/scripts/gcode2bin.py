@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+
+""" Convert G-code to the pre-tokenized format printed with BINARY_GCODE.
+
+The file starts with "MGB" and the format version (1). Each command is a
+record: its length (1 byte), then the body. A tokenized body is the command
+letter (bit 7 set if a subcode byte follows), the command number (uint16),
+the optional subcode, and for each parameter a byte with the letter index
+(bits 0-4) and value type (bits 5-7) followed by the value:
+
+  0  no value
+  1  int8       2  int16        3  int24
+  4  int16/1000 5  int24/1000   6  int24/100000
+  7  float32
+
+A body starting with 0 is a command kept as text, for anything the parser
+needs to see as a string (M23, M117, M118, T? etc.) or doesn't tokenize
+exactly. A record of length 0 stands for '#' (stop buffering).
+
+The print area lines of a Cura header (;MINX:, ;MINY:, ;MAXX:, ;MAXY:) go
+in a text record right after the format version, each between line
+breaks, where CardReader::read_print_area() finds them for 'G29 U'. The
+firmware reads that record as a comment.
+
+Lines are split and comments stripped the way the SD reader does it, and
+each value gets the type that gives the firmware exactly the float strtof
+would have read from the text. With --decode a converted file is printed
+back as G-code for checking.
+"""
+
+from __future__ import print_function
+from __future__ import division
+
+import argparse
+import re
+import struct
+import sys
+from decimal import Decimal
+
+HEADER = b'MGB\x01'
+
+# M-codes that take their arguments as a string
+STRING_MCODES = { 16, 23, 28, 30, 32, 117, 118, 928 } | set(range(810, 820))
+
+VALUE_RUN = re.compile(r'[-+.0-9]*')
+STRTOF = re.compile(r'[-+]?(\d+\.?\d*|\.\d+)')
+COMMAND = re.compile(r'([GMT]) *(\d+)(?:\.(\d+))?')
+PRINT_AREA = re.compile(r'^;(MINX|MINY|MAXX|MAXY):[^\r\n]*', re.M)
+
+def valid_float(s):
+  """ [-+]?.?[0-9] as in GCodeParser::valid_float """
+  if s[:1] in ('-', '+'): s = s[1:]
+  if s[:1] == '.': s = s[1:]
+  return s[:1].isdigit()
+
+def float32(d):
+  """ The float nearest to the Decimal d, ties to even, as strtof gives it. """
+  bits, = struct.unpack('<I', struct.pack('<f', float(d)))
+  best = None
+  for b in (bits - 1, bits, bits + 1):
+    if b < 0 or (b & 0x7F800000) == 0x7F800000: continue
+    f, = struct.unpack('<f', struct.pack('<I', b))
+    err = abs(Decimal(f) - d)
+    if best is None or err < best[0] or (err == best[0] and not b & 1):
+      best = (err, b, f)
+  return struct.pack('<I', best[1])
+
+def encode_value(index, text):
+  """ Descriptor byte and value for one parameter, or None if not exact. """
+  if text is None:
+    return bytes([index])
+  d = Decimal(text)
+  for scale, types in ((1, ((1, 8), (2, 16), (3, 24))), (1000, ((4, 16), (5, 24))), (100000, ((6, 24),))):
+    n = d * scale
+    if n != n.to_integral_value(): continue
+    n = int(n)
+    for typ, width in types:
+      if -(1 << (width - 1)) <= n < (1 << (width - 1)):
+        return bytes([index | typ << 5]) + n.to_bytes(width // 8, 'little', signed=True)
+  if abs(d) >= 1 << 24:
+    return None   # value_long() would lose digits
+  f = float32(d)
+  if int(struct.unpack('<f', f)[0]) != int(d):
+    return None   # value_long() would round up where strtol truncates (e.g., P1.9999999999)
+  return bytes([index | 7 << 5]) + f
+
+def tokenize(line):
+  """ The body of a tokenized command, or None to keep the line as text. """
+  p = line.lstrip(' ')
+  m = re.match(r'N[-+0-9]\d* *', p)
+  if m: p = p[m.end():]
+  star = p.find('*')
+  if star >= 0: p = p[:star].rstrip(' ')
+
+  m = COMMAND.match(p)
+  if not m: return None
+  letter, codenum, subcode = m.group(1), int(m.group(2)), m.group(3)
+  if codenum > 0xFFFF or (subcode is not None and int(subcode) > 0xFF): return None
+  if letter == 'M' and codenum in STRING_MCODES: return None
+  if letter == 'G' and codenum == 53: return None   # Chains another command
+
+  body = bytes([ord(letter) | (0x80 if subcode is not None else 0)]) + struct.pack('<H', codenum)
+  if subcode is not None: body += bytes([int(subcode)])
+
+  p = p[m.end():].lstrip(' ')
+  seen = set()
+  while p:
+    code, p = p[0], p[1:]
+    if not 'A' <= code <= 'Z' or code in seen: return None
+    seen.add(code)
+    p = p.lstrip(' ')
+    value = None
+    if valid_float(p):
+      value = STRTOF.match(p).group(0)
+    elif letter != 'G':
+      return None   # A string argument for M0, M1, etc.
+    if not 'A' <= p[:1] <= 'Z':
+      p = p[VALUE_RUN.match(p).end():].lstrip(' ')
+    enc = encode_value(ord(code) - ord('A'), value)
+    if enc is None: return None
+    body += enc
+  return body
+
+def split_commands(text, paren_comments):
+  """ Commands and '#' marks, as the SD reader finds them. """
+  line, comment, paren = [], False, False
+  for c in text:
+    if c in '\r\n' or (c in '#:' and not comment and not paren):
+      yield ''.join(line)
+      if c == '#': yield '#'
+      line, comment, paren = [], False, False
+    elif c == ';':
+      comment = True
+    elif paren_comments and c == '(':
+      paren = True
+    elif paren_comments and paren and c == ')':
+      paren = False
+    elif not comment and not paren:
+      line.append(c)
+  yield ''.join(line)
+
+def print_area_record(text):
+  """ The print area header lines as a text record, or nothing. """
+  found = {}
+  for m in PRINT_AREA.finditer(text):
+    found.setdefault(m.group(1), m.group(0).rstrip(' \t'))
+  if len(found) < 4: return b''
+  body = b'\0\n' + '\n'.join(found[k] for k in ('MINX', 'MINY', 'MAXX', 'MAXY')).encode('latin-1') + b'\n'
+  return bytes([len(body)]) + body if len(body) < 256 else b''
+
+def convert(text, max_cmd_size, paren_comments):
+  out, stats = bytearray(HEADER), { 'tokenized': 0, 'text': 0 }
+  out += print_area_record(text)
+  for cmd in split_commands(text, paren_comments):
+    if cmd == '#':
+      out.append(0)
+      continue
+    cmd = cmd[:max_cmd_size - 1]   # The SD reader drops the rest
+    if not cmd.strip(' \t'): continue
+    body = tokenize(cmd)
+    if body is not None and len(body) <= max_cmd_size - 3:
+      stats['tokenized'] += 1
+    else:
+      body = b'\0' + cmd.encode('latin-1')
+      stats['text'] += 1
+    out.append(len(body))
+    out += body
+  return bytes(out), stats
+
+def decode(data):
+  if data[:4] != HEADER:
+    sys.exit("not a pre-tokenized G-code file")
+  pos, lines = 4, []
+  while pos < len(data):
+    n = data[pos]
+    body = data[pos + 1:pos + 1 + n]
+    pos += 1 + n
+    if not n:
+      lines.append('#')
+    elif body[0] == 0:
+      lines.append(body[1:].decode('latin-1').strip('\n'))
+    else:
+      s = '%c%d' % (body[0] & 0x7F, body[1] | body[2] << 8)
+      i = 3
+      if body[0] & 0x80:
+        s += '.%d' % body[i]
+        i += 1
+      while i < n:
+        code, typ = chr(ord('A') + (body[i] & 0x1F)), body[i] >> 5
+        i += 1
+        if typ == 0:
+          s += ' ' + code
+          continue
+        if typ == 7:
+          v, = struct.unpack_from('<f', body, i)
+          i += 4
+          s += ' %s%.9g' % (code, v)
+          continue
+        width = (1, 2, 3, 2, 3, 3)[typ - 1]
+        v = int.from_bytes(body[i:i + width], 'little', signed=True)
+        i += width
+        scale = (1, 1, 1, 1000, 1000, 100000)[typ - 1]
+        s += ' %s%s' % (code, v if scale == 1 else str(Decimal(v) / scale))
+      lines.append(s)
+  return lines
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+  parser.add_argument('input', help='G-code file (or converted file with --decode)')
+  parser.add_argument('output', nargs='?', help='output file (default: input with .gcb extension)')
+  parser.add_argument('-m', '--max-cmd-size', type=int, default=96, help='MAX_CMD_SIZE of the firmware (default=96)')
+  parser.add_argument('-p', '--paren-comments', action='store_true', help='strip (comments), as with PAREN_COMMENTS')
+  parser.add_argument('-d', '--decode', action='store_true', help='print a converted file as G-code')
+  args = parser.parse_args()
+
+  if args.decode:
+    with open(args.input, 'rb') as f:
+      print('\n'.join(decode(f.read())))
+    return
+
+  with open(args.input, 'rb') as f:
+    text = f.read().decode('latin-1')
+  data, stats = convert(text, max(32, min(args.max_cmd_size, 255)), args.paren_comments)
+  output = args.output or re.sub(r'\.[^./\\]*$', '', args.input) + '.gcb'
+  with open(output, 'wb') as f:
+    f.write(data)
+  print("%s: %d tokenized, %d as text, %d -> %d bytes (%.1fx)" % (
+    output, stats['tokenized'], stats['text'], len(text), len(data), len(text) / max(1, len(data))))
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+
+""" Fuzz test for FAST_FLOAT_PARSER.
+
+Builds GCodeParser::parse_float() for the host, straight from the
+FAST_FLOAT_PARSER section of Marlin/src/gcode/parser.cpp, and checks that
+it gives the same float as strtof, bit for bit, for:
+
+  - A fixed list of edge cases: signs, zeros, bare points, 2^24 and 2^53
+    neighbours, long mantissas, and values past float range
+  - Random numbers of typical G-code length, up to 9 digits, and up to 45
+  - The exact decimal value of the midpoint of two neighbouring floats,
+    where strtof rounds to even, and the same cut short or nudged by one
+    digit either side
+
+Each value is also tried with text after it (another parameter, a
+checksum, 'E', ...) which parse_float must stop at and leave as it was.
+
+  buildroot/share/scripts/parse_float_fuzz.py [-n COUNT] [--seed SEED]
+
+Needs a C++ compiler ($CXX or c++). Hexadecimal values are left out on
+purpose: strtof reads "0x10" as 16, but parse_float reads it as 0.
+"""
+
+from __future__ import print_function
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+MARLIN = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..', 'Marlin'))
+
+HARNESS = r'''
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <string>
+#include "src/core/macros.h"
+
+struct GCodeParser { static float parse_float(char * const str); };
+
+%(source)s
+
+static uint64_t checked, failures;
+
+static void check(const std::string &num, const char *tail) {
+  const std::string text = num + tail;
+  char buf[160];
+  strcpy(buf, text.c_str());
+  const float a = GCodeParser::parse_float(buf), b = strtof(num.c_str(), nullptr);
+  uint32_t ua, ub;
+  memcpy(&ua, &a, sizeof(a));
+  memcpy(&ub, &b, sizeof(b));
+  ++checked;
+  if (ua != ub || strcmp(buf, text.c_str())) {
+    if (failures++ < 20)
+      printf("FAIL '%%s': parse_float %%.9g (%%08x), strtof %%.9g (%%08x)%%s\n",
+        text.c_str(), a, ua, b, ub, strcmp(buf, text.c_str()) ? ", string changed" : "");
+  }
+}
+
+int main(int argc, char **argv) {
+  const uint64_t count = strtoull(argv[1], nullptr, 10);
+  std::mt19937_64 rng(strtoull(argv[2], nullptr, 10));
+  const char * const tails[] = { "", " ", " Y1", "E5", "e-3", "*34", "X", "\n" };
+
+  const char * const fixed[] = {
+    "0", "-0", "+0", "-0.0", "0.000", ".5", "-.5", "+.5", "5.", "-5.", ".", "-", "-.", "+.", "007", "1.5.3",
+    "16777215", "16777216", "16777217", "16777219", "33554435", "0.16777217",
+    "9007199254740992", "9007199254740993", "1234567890123456789", "12345678901234567890",
+    "123456789012345678901234567890", "0.00000000000000000000000001",
+    "340282346638528859811704183484516925440", "340282356779733661637539395458142568448",
+    "1.000000059604644775390625", "1.00000005960464477539062500000001", "1.0000000596046447753906249999",
+    "0.1", "0.3", "99999999999999999999.5", "2.5", "0.0000001"
+  };
+  for (const char *f : fixed) for (const char *t : tails) check(f, t);
+
+  // Random numbers, mostly as G-code has them
+  for (uint64_t i = 0; i < count; ++i) {
+    std::string s;
+    const unsigned sign = rng() %% 8;
+    if (sign == 0) s += '-'; else if (sign == 1) s += '+';
+    unsigned il, fl;
+    switch (rng() %% 4) {
+      case 0: il = rng() %% 5; fl = rng() %% 6; break;
+      case 1: il = rng() %% 10; fl = rng() %% 10; break;
+      case 2: il = rng() %% 22; fl = rng() %% 25; break;
+      default: il = rng() %% 3; fl = rng() %% 40; break;
+    }
+    if (rng() %% 10 == 0) for (unsigned z = rng() %% 5; z; --z) s += '0';
+    for (unsigned j = 0; j < il; ++j) s += char('0' + rng() %% 10);
+    const bool point = il == 0 || rng() %% 4;
+    if (point) {
+      s += '.';
+      if (!il && !fl) fl = 1;
+      for (unsigned j = 0; j < fl; ++j) s += char('0' + rng() %% 10);
+    }
+    check(s, tails[rng() %% COUNT(tails)]);
+  }
+
+  // Float midpoints, where a double rounding would go wrong
+  for (uint64_t i = 0; i < count / 10; ++i) {
+    const uint32_t bits = 0x2F800000UL + rng() %% 0x4E000000UL; // About 2e-10 to 7e8
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    const long double mid = ((long double)f + nextafterf(f, INFINITY)) / 2;
+    char buf[100];
+    snprintf(buf, sizeof(buf), "%%.70Lf", mid);               // Exact
+    std::string s = buf;
+    while (s.back() == '0') s.pop_back();
+    check(s, "");
+    check(s + "1", "");                                       // Just above
+    std::string below = s;                                    // Just below
+    for (size_t j = below.size(); j--;) {
+      if (below[j] == '.') continue;
+      if (below[j] > '0') { --below[j]; below += '9'; break; }
+      below[j] = '9';
+    }
+    check(below, "");
+    check(s.substr(0, s.find('.') + 1 + rng() %% 30), "");     // Cut short
+  }
+
+  printf("%%llu values checked, %%llu failures\n", (unsigned long long)checked, (unsigned long long)failures);
+  return failures != 0;
+}
+'''
+
+def extract_parse_float():
+  path = os.path.join(MARLIN, 'src', 'gcode', 'parser.cpp')
+  with open(path) as f:
+    text = f.read()
+  m = re.search(r'^#if ENABLED\(FAST_FLOAT_PARSER\)\n(.*?)^#endif // FAST_FLOAT_PARSER$', text, re.M | re.S)
+  if not m:
+    sys.exit('No FAST_FLOAT_PARSER section in ' + path)
+  return '#line %d "%s"\n%s' % (text[:m.start(1)].count('\n') + 1, path, m.group(1))
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+  parser.add_argument('-n', '--count', type=int, default=10000000, help='random values to check (default=10000000)')
+  parser.add_argument('--seed', type=int, default=1, help='random seed (default=1)')
+  args = parser.parse_args()
+
+  work = tempfile.mkdtemp()
+  try:
+    src, exe = os.path.join(work, 'parse_float_fuzz.cpp'), os.path.join(work, 'parse_float_fuzz')
+    with open(src, 'w') as f:
+      f.write(HARNESS % { 'source': extract_parse_float() })
+    cxx = os.environ.get('CXX', 'c++')
+    subprocess.check_call([cxx, '-std=gnu++11', '-O2', '-Wall', '-I' + MARLIN, src, '-o', exe, '-lm'])
+    return subprocess.call([exe, str(args.count), str(args.seed)])
+  finally:
+    shutil.rmtree(work)
+
+if __name__ == '__main__':
+  sys.exit(main())
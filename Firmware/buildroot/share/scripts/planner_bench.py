@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+
+""" Planner look-ahead benchmark.
+
+Generates synthetic G-code corpora, runs each one (plus any G-code files
+given on the command line) through `marlin --planner-bench FILE` and
+tabulates the results: blocks planned per second of host time, the cost of
+a single Planner::buffer_line call (mean / p99 / max), the printing time
+each block buys, and the number of blocks revisited by each look-ahead pass
+(mean / max per recalculate()).
+
+Build the simulator with the linux_planner_bench environment, which enables
+PLANNER_STATS for the pass counters:
+
+  pio run -e linux_planner_bench
+  buildroot/share/scripts/planner_bench.py my_print.gcode
+
+Synthetic corpora:
+  arcs    Concentric arcs of varying radius, as short chords
+  stl     Tessellated free-form curves with tiny segments and facet noise
+  vase    Continuous spiral with Z rising along every segment
+  infill  45 degree zig-zag infill with short turn segments
+"""
+
+from __future__ import print_function
+from __future__ import division
+
+import argparse
+import math
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+E_PER_MM = 0.033  # 0.4 x 0.2 mm line from 1.75 mm filament
+
+class Writer:
+  def __init__(self, path):
+    self.f = open(path, 'w')
+    self.e = 0.0
+    self.x = self.y = self.z = None
+    self.f.write('G90\nM82\nG92 E0\n')
+
+  def travel(self, x, y, z, feed):
+    self.f.write('G0 X%.3f Y%.3f Z%.3f F%d\n' % (x, y, z, feed))
+    self.x, self.y, self.z = x, y, z
+
+  def extrude(self, x, y, z=None, feed=None):
+    d = math.hypot(x - self.x, y - self.y)
+    self.e += d * E_PER_MM
+    cmd = 'G1 X%.3f Y%.3f' % (x, y)
+    if z is not None and z != self.z:
+      cmd += ' Z%.3f' % z
+      self.z = z
+    cmd += ' E%.5f' % self.e
+    if feed: cmd += ' F%d' % feed
+    self.f.write(cmd + '\n')
+    self.x, self.y = x, y
+
+  def close(self):
+    self.f.close()
+
+def gen_arcs(path, moves, seg, cx, cy):
+  w = Writer(path)
+  n = 0
+  r = 2.0
+  while n < moves:
+    start = random.uniform(0, 2 * math.pi)
+    sweep = random.uniform(math.pi / 2, 2 * math.pi) * random.choice((-1, 1))
+    steps = max(2, int(abs(sweep) * r / seg))
+    w.travel(cx + r * math.cos(start), cy + r * math.sin(start), 0.2, 9000)
+    for i in range(1, steps + 1):
+      a = start + sweep * i / steps
+      w.extrude(cx + r * math.cos(a), cy + r * math.sin(a), feed=3000 if i == 1 else None)
+    n += steps + 1
+    r = r + 0.4 if r < 40 else 2.0
+  w.close()
+
+def gen_stl(path, moves, seg, cx, cy):
+  # Outline of a blobby solid sliced from an STL: a wobbly closed curve
+  # with every vertex jittered as if snapped to a facet
+  w = Writer(path)
+  n, z = 0, 0.2
+  while n < moves:
+    k1, k2 = random.randint(3, 7), random.randint(8, 15)
+    p1, p2 = random.uniform(0, 6.3), random.uniform(0, 6.3)
+    radius = lambda a: 25 + 4 * math.sin(k1 * a + p1) + 1.5 * math.sin(k2 * a + p2)
+    steps = int(2 * math.pi * 25 / seg)
+    w.travel(cx + radius(0), cy, z, 9000)
+    for i in range(1, steps + 1):
+      a = 2 * math.pi * i / steps
+      r = radius(a) + random.uniform(-0.002, 0.002)
+      w.extrude(cx + r * math.cos(a), cy + r * math.sin(a), feed=2400 if i == 1 else None)
+    n += steps + 1
+    z += 0.2
+  w.close()
+
+def gen_vase(path, moves, seg, cx, cy):
+  w = Writer(path)
+  layer, z = 0.2, 0.2
+  r0 = 20.0
+  w.travel(cx + r0, cy, z, 9000)
+  a = 0.0
+  for i in range(moves):
+    r = r0 + 3 * math.sin(6 * a) * math.sin(z / 10)
+    a += seg / r
+    z += layer * seg / (2 * math.pi * r)
+    r = r0 + 3 * math.sin(6 * a) * math.sin(z / 10)
+    w.extrude(cx + r * math.cos(a), cy + r * math.sin(a), z, feed=1800 if i == 0 else None)
+  w.close()
+
+def gen_infill(path, moves, seg, cx, cy):
+  w = Writer(path)
+  size, spacing = 40.0, 0.45
+  n, z = 0, 0.2
+  while n < moves:
+    w.travel(cx - size / 2, cy - size / 2, z, 9000)
+    # Lines at 45 degrees across a square, joined by short turns
+    d = -size
+    flip = False
+    while d < size and n < moves:
+      x0, y0 = max(-size / 2, d - size / 2), max(-size / 2, -d - size / 2)
+      x1, y1 = min(size / 2, d + size / 2), min(size / 2, size / 2 - d)
+      a, b = ((x0, y0), (x1, y1)) if not flip else ((x1, y1), (x0, y0))
+      w.extrude(cx + a[0], cy + a[1], z, feed=6000)
+      w.extrude(cx + b[0], cy + b[1])
+      flip = not flip
+      d += spacing * math.sqrt(2)
+      n += 2
+    z += 0.2
+  w.close()
+
+GENERATORS = { 'arcs': gen_arcs, 'stl': gen_stl, 'vase': gen_vase, 'infill': gen_infill }
+
+def run(marlin, corpus):
+  proc = subprocess.run([marlin, '--planner-bench', corpus], stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+  if proc.returncode:
+    sys.exit("%s failed on %s:\n%s" % (marlin, corpus, proc.stderr))
+  result = {}
+  for line in proc.stderr.splitlines():
+    key, sep, value = line.partition(':')
+    if sep: result[key.strip()] = value.split()
+  return result
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument('gcode', nargs='*', help='real G-code files to add to the corpora')
+  parser.add_argument('-m', '--marlin', default='.pio/build/linux_planner_bench/program', help='simulator binary (default=%(default)s)')
+  parser.add_argument('-c', '--corpus', action='append', choices=sorted(GENERATORS), help='synthetic corpus to run (default=all)')
+  parser.add_argument('-n', '--moves', type=int, default=20000, help='moves per synthetic corpus (default=20000)')
+  parser.add_argument('-s', '--segment', type=float, default=0.05, help='segment length in mm for curves (default=0.05)')
+  parser.add_argument('--center', type=float, nargs=2, default=(100.0, 100.0), metavar=('X', 'Y'), help='bed position of the corpora (default=100 100)')
+  parser.add_argument('--keep', metavar='DIR', help='write the synthetic corpora to DIR and keep them')
+  args = parser.parse_args()
+
+  if not os.path.exists(args.marlin):
+    sys.exit("%s not found. Build it with: pio run -e linux_planner_bench" % args.marlin)
+
+  random.seed(1)
+  outdir = args.keep or tempfile.mkdtemp(prefix='planner_bench')
+  if args.keep and not os.path.isdir(outdir): os.makedirs(outdir)
+
+  corpora = []
+  for name in args.corpus or sorted(GENERATORS):
+    path = os.path.join(outdir, name + '.gcode')
+    GENERATORS[name](path, args.moves, args.segment, *args.center)
+    corpora.append((name, path))
+  corpora += [(os.path.basename(p), p) for p in args.gcode]
+
+  print("%-14s %8s %10s %8s %8s %8s %10s %11s %11s %11s" % (
+    'corpus', 'blocks', 'blocks/s', 'mean us', 'p99 us', 'max us', 'motion us', 'reverse', 'forward', 'trapezoid'))
+  for name, path in corpora:
+    r = run(args.marlin, path)
+    line_us = [float(v) for v in r.get('buffer_line_us', ['0'] * 4)]
+    passes = ['%6s/%-4s' % tuple(r[k]) if k in r else '%11s' % '-' for k in ('reverse_pass', 'forward_pass', 'trapezoid_pass')]
+    print("%-14s %8s %10s %8.2f %8.2f %8.2f %10s %s %s %s" % (
+      name[:14], r['blocks'][0], r['blocks_per_second'][0], line_us[0], line_us[2], line_us[3],
+      r['motion_us_per_block'][0], *passes))
+  print("block_buffer_size: %s" % r['block_buffer_size'][0])
+
+  if not args.keep:
+    for _, path in corpora[:len(corpora) - len(args.gcode)]: os.remove(path)
+    os.rmdir(outdir)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+
+""" Rebuild per-axis motion profiles from a Linux simulator step log.
+
+Reads the binary file written by `marlin --step-log FILE` (see
+Marlin/src/HAL/HAL_LINUX/hardware/StepLogger.h) and reports, per axis:
+steps taken in each direction, final position, peak velocity, acceleration
+and jerk, and step interval jitter. With --csv the full time series are
+written as <prefix>_<axis>.csv. With --compare a second log is checked
+against the first for lost/extra steps and timing differences.
+
+Velocity is computed over a moving window of --window steps, so the
+derivatives are not swamped by step quantization.
+"""
+
+from __future__ import print_function
+from __future__ import division
+
+import argparse
+import struct
+import sys
+
+GAP = 0x7F
+
+def read_log(path):
+  with open(path, 'rb') as f:
+    data = f.read()
+  if data[:4] != b'MSTP':
+    sys.exit("%s: not a step log" % path)
+  version, count = data[4], data[5]
+  if version != 1:
+    sys.exit("%s: unsupported version %d" % (path, version))
+  pos = 6
+  axes = []
+  for _ in range(count):
+    name = chr(data[pos])
+    spm, = struct.unpack_from('<f', data, pos + 1)
+    axes.append({ 'name': name, 'steps_per_mm': spm, 't': [], 'dir': [] })
+    pos += 5
+  t = 0
+  for delta, flags in struct.iter_unpack('<IB', data[pos:pos + (len(data) - pos) // 5 * 5]):
+    t += delta
+    axis = flags & 0x7F
+    if axis == GAP or axis >= count: continue
+    axes[axis]['t'].append(t)
+    axes[axis]['dir'].append(1 if flags & 0x80 else -1)
+  return axes
+
+def derivative(t, v, span):
+  """ Difference of v over t between samples 'span' apart, at the midpoints. """
+  tm, dv = [], []
+  for i in range(span, len(t)):
+    dt = t[i] - t[i - span]
+    if dt <= 0: continue
+    tm.append((t[i] + t[i - span]) / 2)
+    dv.append((v[i] - v[i - span]) / dt)
+  return tm, dv
+
+def profile(axis, window, idle_s):
+  """ Velocity/acceleration/jerk series for one axis, in mm and seconds. """
+  t = [ns / 1e9 for ns in axis['t']]
+  d = axis['dir']
+  spm = axis['steps_per_mm'] or 1.0
+  tv, v = [], []
+  start = 0
+  for i in range(1, len(t) + 1):
+    # A long pause or a direction change ends a motion segment
+    if i == len(t) or t[i] - t[i - 1] > idle_s or d[i] != d[i - 1]:
+      seg_t, seg_d = t[start:i], d[start:i]
+      for j in range(window, len(seg_t)):
+        dt = seg_t[j] - seg_t[j - window]
+        if dt > 0:
+          tv.append((seg_t[j] + seg_t[j - window]) / 2)
+          v.append(seg_d[j] * window / spm / dt)
+      start = i
+  ta, a = derivative(tv, v, window)
+  tj, j = derivative(ta, a, window)
+  return (tv, v), (ta, a), (tj, j)
+
+def jitter(axis, idle_s):
+  """ 99th percentile of each step interval's deviation from the trend of its neighbours, relative. """
+  t, d = axis['t'], axis['dir']
+  dev = []
+  for i in range(3, len(t)):
+    if not d[i] == d[i - 1] == d[i - 2] == d[i - 3]: continue
+    a, b, c = t[i - 2] - t[i - 3], t[i - 1] - t[i - 2], t[i] - t[i - 1]
+    if min(a, b, c) <= 0 or max(a, b, c) > idle_s * 1e9: continue
+    dev.append(abs(a - 2 * b + c) / b)
+  if not dev: return 0.0
+  dev.sort()
+  return dev[int(len(dev) * 0.99)]
+
+def peak(series):
+  return max([abs(x) for x in series[1]] or [0.0])
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument('log', help='step log written by --step-log')
+  parser.add_argument('-w', '--window', type=int, default=8, help='steps per velocity sample (default=8)')
+  parser.add_argument('-i', '--idle', type=float, default=0.05, help='gap in seconds that ends a move (default=0.05)')
+  parser.add_argument('-c', '--csv', metavar='PREFIX', help='write <PREFIX>_<axis>.csv time series')
+  parser.add_argument('--compare', metavar='LOG', help='second log to check against the first')
+  args = parser.parse_args()
+
+  axes = read_log(args.log)
+
+  print("%-4s %10s %10s %12s %10s %12s %14s %11s" % ('axis', '+steps', '-steps', 'position mm', 'v mm/s', 'a mm/s^2', 'j mm/s^3', 'jitter p99'))
+  for axis in axes:
+    fwd = axis['dir'].count(1)
+    rev = len(axis['dir']) - fwd
+    vel, acc, jerk = profile(axis, max(1, args.window), args.idle)
+    print("%-4s %10d %10d %12.3f %10.2f %12.1f %14.1f %10.1f%%" % (
+      axis['name'], fwd, rev, (fwd - rev) / (axis['steps_per_mm'] or 1.0),
+      peak(vel), peak(acc), peak(jerk), jitter(axis, args.idle) * 100))
+
+    if args.csv:
+      with open('%s_%s.csv' % (args.csv, axis['name']), 'w') as f:
+        f.write('kind,time_s,value\n')
+        for kind, (ts, vs) in (('v', vel), ('a', acc), ('j', jerk)):
+          for tt, vv in zip(ts, vs):
+            f.write('%s,%.9f,%.6f\n' % (kind, tt, vv))
+
+  if args.compare:
+    other = read_log(args.compare)
+    print()
+    print("%-4s %12s %12s %16s" % ('axis', 'net diff', 'count diff', 'max dt diff us'))
+    status = 0
+    for a, b in zip(axes, other):
+      net = sum(b['dir']) - sum(a['dir'])
+      cnt = len(b['t']) - len(a['t'])
+      dt = max([abs(x - y) for x, y in zip(a['t'], b['t'])] or [0]) / 1000.0
+      if net or cnt: status = 1
+      print("%-4s %12d %12d %16.3f" % (a['name'], net, cnt, dt))
+    sys.exit(status)
+
+if __name__ == '__main__':
+  main()